@@ -0,0 +1,143 @@
+#pragma once
+
+#include "include_file.h"
+
+// Bump allocator for per-batch intermediates, usable anywhere a
+// std::pmr::memory_resource is accepted.
+//
+// allocate() advances a pointer inside the current block; deallocate() does
+// nothing; reset() rewinds to the start in O(1) once the batch is done, so
+// everything allocated for the batch is released at once. Unlike
+// std::pmr::monotonic_buffer_resource::release(), reset() keeps the memory:
+// when a batch needed more than one block, the next reset() replaces them
+// with a single block of the combined size, so from the second batch of a
+// given shape on, serving makes no upstream (heap) allocations at all.
+//
+// Not thread-safe: use one arena per thread or per in-flight batch.
+class BumpArena : public std::pmr::memory_resource
+{
+private:
+    struct Block
+    {
+        char *data;
+        size_t size;
+    };
+
+    std::pmr::memory_resource *upstream;
+    std::vector<Block> blocks;
+    size_t current = 0; // block being bumped
+    size_t offset = 0;  // first free byte in blocks[current]
+    size_t used = 0;    // bytes handed out since the last reset, including padding
+    size_t peak = 0;
+    size_t upstreamAllocations = 0;
+
+    static constexpr size_t blockAlignment = alignof(std::max_align_t);
+
+    void addBlock(size_t size)
+    {
+        blocks.push_back(Block{static_cast<char *>(upstream->allocate(size, blockAlignment)), size});
+        ++upstreamAllocations;
+    }
+
+    void releaseBlocks()
+    {
+        for (const Block &block : blocks)
+        {
+            upstream->deallocate(block.data, block.size, blockAlignment);
+        }
+        blocks.clear();
+    }
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        for (;;)
+        {
+            const Block &block = blocks[current];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            const size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+            if (aligned <= block.size && bytes <= block.size - aligned)
+            {
+                used += aligned - offset + bytes;
+                peak = std::max(peak, used);
+                offset = aligned + bytes;
+                return block.data + aligned;
+            }
+            used += block.size - offset; // the tail of this block is wasted until reset
+            if (current + 1 == blocks.size())
+            {
+                addBlock(std::max(2 * block.size, bytes + alignment));
+            }
+            ++current;
+            offset = 0;
+        }
+    }
+
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    explicit BumpArena(size_t initial_bytes = size_t(1) << 20,
+                       std::pmr::memory_resource *upstream_resource = std::pmr::new_delete_resource())
+        : upstream(upstream_resource)
+    {
+        addBlock(std::max<size_t>(initial_bytes, 64));
+    }
+
+    BumpArena(const BumpArena &) = delete;
+    BumpArena &operator=(const BumpArena &) = delete;
+
+    ~BumpArena() override
+    {
+        releaseBlocks();
+    }
+
+    // Frees everything allocated since the last reset. O(1) unless the
+    // batch overflowed into extra blocks, which are merged into one.
+    void reset()
+    {
+        if (blocks.size() > 1)
+        {
+            size_t total = 0;
+            for (const Block &block : blocks)
+            {
+                total += block.size;
+            }
+            releaseBlocks();
+            addBlock(total);
+        }
+        current = 0;
+        offset = 0;
+        used = 0;
+    }
+
+    size_t bytesUsed() const
+    {
+        return used;
+    }
+
+    size_t peakBytes() const
+    {
+        return peak;
+    }
+
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (const Block &block : blocks)
+        {
+            total += block.size;
+        }
+        return total;
+    }
+
+    // Blocks requested from upstream over the arena's lifetime
+    size_t getUpstreamAllocations() const
+    {
+        return upstreamAllocations;
+    }
+};
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "include_file.h"
+#include "Simd.h"
+
+// Batch bin assignment (like pd.cut) shared by the binning classes.
+//
+// Bin i holds edges[i] <= v < edges[i + 1]. Values below the first interior
+// edge (and NaN) go to bin 0, values at or above the last interior edge go
+// to the last bin.
+//
+// Equal-width edges are detected and resolved arithmetically in O(1), with a
+// one-step fix-up against the stored edges so rounding never disagrees with
+// getBinEdges(). Edges that are only roughly even (quantile tables of
+// well-behaved data) go through a bucket table: an equal-width grid over the
+// interior edges maps a value to the first edge of its cell, and a branch-free
+// binary search over the few edges in that cell (at most 15) finishes the job.
+// Otherwise the interior edges are searched branch-free over an Eytzinger
+// (BFS-ordered) copy of the interior edges: every lookup runs the same fixed
+// number of steps, several lookups are interleaved to hide the cache misses,
+// and with AVX2 the steps are done 4 (double) or 8 (float) lanes at a time
+// with gathers.
+template <typename T>
+class BinCutter
+{
+private:
+    size_t numBins = 0;
+
+    // equal-width path
+    bool uniform = false;
+    double low = 0.0;
+    double inverseWidth = 0.0;
+    std::vector<T> bounds; // edges with open first / last edge, numBins + 1 entries
+
+    // bucket path: cellBase[c] = number of interior edges in cells before c,
+    // sorted = interior edges padded with window copies of the largest value
+    bool bucketed = false;
+    std::vector<uint32_t> cellBase;
+    std::vector<T> sorted;
+    size_t window = 0;
+    double cellLow = 0.0;
+    double cellScale = 0.0;
+
+    // Eytzinger path: tree[1 .. 2^depth - 1], padded with the largest value
+    std::vector<T> tree;
+    size_t depth = 0;
+
+    static constexpr size_t block = 16;
+
+    static T largest()
+    {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    static T smallest()
+    {
+        return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    }
+
+    void buildTree(const std::vector<T> &interior, size_t node, size_t &next)
+    {
+        if (node >= tree.size())
+        {
+            return;
+        }
+        buildTree(interior, 2 * node, next);
+        tree[node] = next < interior.size() ? interior[next] : largest();
+        ++next;
+        buildTree(interior, 2 * node + 1, next);
+    }
+
+    size_t uniformBin(T value) const
+    {
+        double x = (static_cast<double>(value) - low) * inverseWidth;
+        x = x > 0.0 ? x : 0.0; // also maps NaN to 0
+        x = x < static_cast<double>(numBins - 1) ? x : static_cast<double>(numBins - 1);
+        size_t bin = static_cast<size_t>(x);
+        bin -= static_cast<size_t>(value < bounds[bin]);
+        bin += static_cast<size_t>(value >= bounds[bin + 1]);
+        return std::min(bin, numBins - 1);
+    }
+
+    size_t cellOf(T value) const
+    {
+        double x = (static_cast<double>(value) - cellLow) * cellScale;
+        x = x > 0.0 ? x : 0.0; // also maps NaN to cell 0
+        x = x < static_cast<double>(cellBase.size() - 1) ? x : static_cast<double>(cellBase.size() - 1);
+        return static_cast<size_t>(x);
+    }
+
+    // Cells are assigned with the same monotone formula for edges and values,
+    // so every edge in an earlier cell is <= value and every edge in a later
+    // cell is > value; only the value's own cell needs searching
+    size_t bucketBin(T value) const
+    {
+        size_t position = cellBase[cellOf(value)];
+        for (size_t step = window / 2; step > 0; step /= 2)
+        {
+            position += static_cast<size_t>(sorted[position + step - 1] <= value) * step;
+        }
+        return std::min(position, numBins - 1); // +inf also passes the padding
+    }
+
+    bool buildBuckets(const std::vector<T> &interior)
+    {
+        const double first = static_cast<double>(interior.front());
+        const double last = static_cast<double>(interior.back());
+        if (!(last > first) || !std::isfinite(last - first))
+        {
+            return false;
+        }
+
+        size_t cells = 1;
+        while (cells < 4 * interior.size())
+        {
+            cells *= 2;
+        }
+        cellLow = first;
+        cellScale = static_cast<double>(cells) / (last - first);
+        cellBase.assign(cells, 0);
+
+        std::vector<uint32_t> counts(cells, 0);
+        for (const T &edge : interior)
+        {
+            ++counts[cellOf(edge)];
+        }
+        const uint32_t largestCell = *std::max_element(counts.begin(), counts.end());
+        if (largestCell >= 16)
+        {
+            cellBase.clear();
+            return false;
+        }
+        uint32_t before = 0;
+        for (size_t c = 0; c < cells; ++c)
+        {
+            cellBase[c] = before;
+            before += counts[c];
+        }
+
+        window = 1;
+        while (window <= largestCell)
+        {
+            window *= 2;
+        }
+        sorted = interior;
+        sorted.resize(interior.size() + window, largest());
+        return true;
+    }
+
+    size_t treeBin(T value) const
+    {
+        size_t node = 1;
+        for (size_t d = 0; d < depth; ++d)
+        {
+            node = 2 * node + static_cast<size_t>(tree[node] <= value);
+        }
+        return std::min(node - (size_t(1) << depth), numBins - 1);
+    }
+
+    template <typename Code>
+    void treeBlock(const T *input, size_t count, Code *codes) const
+    {
+        size_t nodes[block];
+        for (size_t j = 0; j < count; ++j)
+        {
+            nodes[j] = 1;
+        }
+        for (size_t d = 0; d < depth; ++d)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                nodes[j] = 2 * nodes[j] + static_cast<size_t>(tree[nodes[j]] <= input[j]);
+            }
+        }
+        const size_t leaf = size_t(1) << depth;
+        for (size_t j = 0; j < count; ++j)
+        {
+            codes[j] = static_cast<Code>(std::min(nodes[j] - leaf, numBins - 1));
+        }
+    }
+
+#if defined(__AVX2__)
+    template <typename Code>
+    void treeBlockAvx2(const double *input, Code *codes) const
+    {
+        // 4 independent groups of 4 lanes
+        __m256i nodes[4];
+        __m256d values[4];
+        for (size_t g = 0; g < 4; ++g)
+        {
+            nodes[g] = _mm256_set1_epi64x(1);
+            values[g] = _mm256_loadu_pd(input + 4 * g);
+        }
+        for (size_t d = 0; d < depth; ++d)
+        {
+            for (size_t g = 0; g < 4; ++g)
+            {
+                const __m256d keys = _mm256_i64gather_pd(tree.data(), nodes[g], 8);
+                const __m256i goRight = _mm256_castpd_si256(_mm256_cmp_pd(keys, values[g], _CMP_LE_OQ));
+                nodes[g] = _mm256_sub_epi64(_mm256_slli_epi64(nodes[g], 1), goRight);
+            }
+        }
+        const int64_t leaf = int64_t(1) << depth;
+        alignas(32) int64_t lanes[4];
+        for (size_t g = 0; g < 4; ++g)
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), nodes[g]);
+            for (size_t l = 0; l < 4; ++l)
+            {
+                codes[4 * g + l] = static_cast<Code>(std::min<size_t>(lanes[l] - leaf, numBins - 1));
+            }
+        }
+    }
+
+    template <typename Code>
+    void treeBlockAvx2(const float *input, Code *codes) const
+    {
+        // 2 independent groups of 8 lanes
+        __m256i nodes[2];
+        __m256 values[2];
+        for (size_t g = 0; g < 2; ++g)
+        {
+            nodes[g] = _mm256_set1_epi32(1);
+            values[g] = _mm256_loadu_ps(input + 8 * g);
+        }
+        for (size_t d = 0; d < depth; ++d)
+        {
+            for (size_t g = 0; g < 2; ++g)
+            {
+                const __m256 keys = _mm256_i32gather_ps(tree.data(), nodes[g], 4);
+                const __m256i goRight = _mm256_castps_si256(_mm256_cmp_ps(keys, values[g], _CMP_LE_OQ));
+                nodes[g] = _mm256_sub_epi32(_mm256_slli_epi32(nodes[g], 1), goRight);
+            }
+        }
+        const int32_t leaf = int32_t(1) << depth;
+        alignas(32) int32_t lanes[8];
+        for (size_t g = 0; g < 2; ++g)
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), nodes[g]);
+            for (size_t l = 0; l < 8; ++l)
+            {
+                codes[8 * g + l] = static_cast<Code>(std::min<size_t>(lanes[l] - leaf, numBins - 1));
+            }
+        }
+    }
+#endif
+
+public:
+    BinCutter() = default;
+
+    explicit BinCutter(const std::vector<T> &edges)
+    {
+        if (edges.size() < 2)
+        {
+            throw std::invalid_argument("At least two bin edges are required");
+        }
+
+        numBins = edges.size() - 1;
+        bounds = edges;
+        bounds.front() = smallest();
+        bounds.back() = largest();
+
+        const double first = static_cast<double>(edges.front());
+        const double last = static_cast<double>(edges.back());
+        const double width = (last - first) / numBins;
+        uniform = std::isfinite(width) && width > 0.0;
+        for (size_t i = 1; uniform && i < numBins; ++i)
+        {
+            const double expected = first + i * width;
+            uniform = std::abs(static_cast<double>(edges[i]) - expected) <= 1e-9 * std::max(std::abs(expected), width);
+        }
+        if (uniform)
+        {
+            low = first;
+            inverseWidth = 1.0 / width;
+            return;
+        }
+
+        const std::vector<T> interior(edges.begin() + 1, edges.end() - 1);
+        if (!interior.empty() && interior.size() <= std::numeric_limits<uint32_t>::max() / 8 &&
+            std::is_sorted(interior.begin(), interior.end()) && buildBuckets(interior))
+        {
+            bucketed = true;
+            return;
+        }
+
+        depth = 0;
+        while ((size_t(1) << depth) - 1 < interior.size())
+        {
+            ++depth;
+        }
+        tree.assign(size_t(1) << depth, largest());
+        size_t next = 0;
+        buildTree(interior, 1, next);
+    }
+
+    size_t getNumBins() const
+    {
+        return numBins;
+    }
+
+    bool isUniform() const
+    {
+        return uniform;
+    }
+
+    bool isBucketed() const
+    {
+        return bucketed;
+    }
+
+    size_t operator()(T value) const
+    {
+        return uniform ? uniformBin(value) : bucketed ? bucketBin(value) : treeBin(value);
+    }
+
+    // Writes the bin code of input[i] to codes[i]; Code is typically uint8_t
+    // or uint16_t and must be able to hold numBins - 1
+    template <typename Code>
+    void cut(const T *input, size_t n, Code *codes) const
+    {
+        if (numBins == 0)
+        {
+            throw std::logic_error("BinCutter has no edges");
+        }
+        if (numBins - 1 > static_cast<size_t>(std::numeric_limits<Code>::max()))
+        {
+            throw std::invalid_argument("Too many bins for the bin code type");
+        }
+
+        if (uniform)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                codes[i] = static_cast<Code>(uniformBin(input[i]));
+            }
+            return;
+        }
+        if (bucketed)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                codes[i] = static_cast<Code>(bucketBin(input[i]));
+            }
+            return;
+        }
+
+        size_t i = 0;
+#if defined(__AVX2__)
+        if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>)
+        {
+            for (; i + block <= n; i += block)
+            {
+                treeBlockAvx2(input + i, codes + i);
+            }
+        }
+#endif
+        for (; i < n; i += block)
+        {
+            treeBlock(input + i, std::min(block, n - i), codes + i);
+        }
+    }
+
+    std::vector<size_t> cut(const std::vector<T> &input) const
+    {
+        std::vector<size_t> result(input.size());
+        cut(input.data(), input.size(), result.data());
+        return result;
+    }
+};
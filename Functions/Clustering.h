@@ -0,0 +1,514 @@
+#pragma once
+
+// Multi-dimensional k-means over a contiguous row-major matrix
+// (vector quantisation, cluster-id / cluster-distance features)
+
+#include "include_file.h"
+#include "Parallel.h"
+#include "Simd.h"
+
+// K-MEANS
+// fit:          greedy k-means++ seeding + Hamerly's bounds (one upper bound to the
+//               assigned centre, one lower bound to the second closest), so
+//               most points skip the k distance computations once the
+//               centres settle. Assignment and update are multi-threaded.
+// fitMiniBatch: Sculley's mini-batch k-means for data that does not fit in
+//               cache; each step only touches batch_size rows.
+// Results are reproducible for a given seed.
+template <typename T>
+class KMeans
+{
+private:
+    size_t numClusters;
+    size_t maxIterations;
+    double tolerance;
+    uint64_t seed;
+    size_t numThreads;
+
+    size_t dims = 0;
+    std::vector<T> centroids; // numClusters x dims
+    std::vector<uint32_t> labels;
+    double inertia = 0.0;
+    size_t iterationsRun = 0;
+
+    const T *centroid(size_t c) const
+    {
+        return &centroids[c * dims];
+    }
+
+    // nearest and second nearest centre (squared distances)
+    void nearestTwo(const T *point, uint32_t &best, double &bestDistance, double &secondDistance) const
+    {
+        best = 0;
+        bestDistance = std::numeric_limits<double>::infinity();
+        secondDistance = std::numeric_limits<double>::infinity();
+        for (size_t c = 0; c < numClusters; ++c)
+        {
+            const double distance = squared_distance(point, centroid(c), dims);
+            if (distance < bestDistance)
+            {
+                secondDistance = bestDistance;
+                bestDistance = distance;
+                best = static_cast<uint32_t>(c);
+            }
+            else if (distance < secondDistance)
+            {
+                secondDistance = distance;
+            }
+        }
+    }
+
+    // Greedy k-means++ (as in sklearn): each step draws 2 + log(k) candidates
+    // by D^2 sampling and keeps the one that lowers the potential the most
+    void seedPlusPlus(const T *data, size_t n, std::mt19937_64 &rng)
+    {
+        centroids.assign(numClusters * dims, T(0));
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        const size_t first = pick(rng);
+        std::copy(data + first * dims, data + first * dims + dims, centroids.begin());
+
+        // squared distance of every point to its closest chosen centre
+        std::vector<double> closest(n);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    closest[i] = squared_distance(data + i * dims, data + first * dims, dims);
+                }
+            },
+            numThreads);
+
+        const size_t trials = 2 + static_cast<size_t>(std::log(static_cast<double>(numClusters)));
+        std::vector<size_t> candidates(trials);
+        std::vector<double> cumulative(n);
+        const size_t workers = parallel_workers(n, numThreads);
+        std::vector<double> potentials(workers * trials);
+
+        for (size_t c = 1; c < numClusters; ++c)
+        {
+            // D^2 sampling
+            std::partial_sum(closest.begin(), closest.end(), cumulative.begin());
+            const double total = cumulative.back();
+            for (auto &candidate : candidates)
+            {
+                if (total > 0.0)
+                {
+                    const double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+                    candidate = std::min<size_t>(n - 1, std::upper_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin());
+                }
+                else
+                {
+                    candidate = pick(rng);
+                }
+            }
+
+            std::fill(potentials.begin(), potentials.end(), 0.0);
+            parallel_for(
+                n,
+                [&](size_t begin, size_t end, size_t worker)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        for (size_t t = 0; t < trials; ++t)
+                        {
+                            const double distance = squared_distance(data + i * dims, data + candidates[t] * dims, dims);
+                            potentials[worker * trials + t] += std::min(closest[i], distance);
+                        }
+                    }
+                },
+                numThreads);
+
+            size_t best = 0;
+            double bestPotential = std::numeric_limits<double>::infinity();
+            for (size_t t = 0; t < trials; ++t)
+            {
+                double potential = 0.0;
+                for (size_t w = 0; w < workers; ++w)
+                {
+                    potential += potentials[w * trials + t];
+                }
+                if (potential < bestPotential)
+                {
+                    bestPotential = potential;
+                    best = t;
+                }
+            }
+
+            const T *chosen = data + candidates[best] * dims;
+            std::copy(chosen, chosen + dims, centroids.begin() + c * dims);
+            parallel_for(
+                n,
+                [&](size_t begin, size_t end, size_t)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        closest[i] = std::min<double>(closest[i], squared_distance(data + i * dims, chosen, dims));
+                    }
+                },
+                numThreads);
+        }
+    }
+
+    // New centres as the mean of their points: points are grouped by label
+    // (counting sort) and each thread sums a range of clusters
+    std::vector<T> computeCentroids(const T *data, size_t n) const
+    {
+        std::vector<size_t> starts(numClusters + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            starts[labels[i] + 1]++;
+        }
+        for (size_t c = 0; c < numClusters; ++c)
+        {
+            starts[c + 1] += starts[c];
+        }
+        std::vector<size_t> order(n);
+        std::vector<size_t> fill(starts.begin(), starts.end() - 1);
+        for (size_t i = 0; i < n; ++i)
+        {
+            order[fill[labels[i]]++] = i;
+        }
+
+        std::vector<T> updated = centroids;
+        parallel_for(
+            numClusters,
+            [&](size_t begin, size_t end, size_t)
+            {
+                std::vector<double> sum(dims);
+                for (size_t c = begin; c < end; ++c)
+                {
+                    if (starts[c] == starts[c + 1])
+                    {
+                        continue; // empty cluster keeps its centre
+                    }
+                    std::fill(sum.begin(), sum.end(), 0.0);
+                    for (size_t k = starts[c]; k < starts[c + 1]; ++k)
+                    {
+                        const T *point = data + order[k] * dims;
+                        for (size_t j = 0; j < dims; ++j)
+                        {
+                            sum[j] += point[j];
+                        }
+                    }
+                    const double count = static_cast<double>(starts[c + 1] - starts[c]);
+                    for (size_t j = 0; j < dims; ++j)
+                    {
+                        updated[c * dims + j] = static_cast<T>(sum[j] / count);
+                    }
+                }
+            },
+            numThreads, 1);
+        return updated;
+    }
+
+    // mean per-feature variance, used to scale the tolerance like sklearn;
+    // one row-major pass with per-worker column sums, shifted by the first
+    // row so the sums of squares do not cancel
+    double meanVariance(const T *data, size_t n) const
+    {
+        const size_t workers = parallel_workers(n, numThreads);
+        std::vector<double> sums(workers * dims, 0.0), squares(workers * dims, 0.0);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                double *sum = &sums[worker * dims];
+                double *square = &squares[worker * dims];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const T *point = data + i * dims;
+                    for (size_t j = 0; j < dims; ++j)
+                    {
+                        const double shifted = static_cast<double>(point[j]) - static_cast<double>(data[j]);
+                        sum[j] += shifted;
+                        square[j] += shifted * shifted;
+                    }
+                }
+            },
+            numThreads);
+
+        double total = 0.0;
+        for (size_t j = 0; j < dims; ++j)
+        {
+            double sum = 0.0, square = 0.0;
+            for (size_t w = 0; w < workers; ++w)
+            {
+                sum += sums[w * dims + j];
+                square += squares[w * dims + j];
+            }
+            total += std::max(0.0, square - sum * sum / static_cast<double>(n)) / static_cast<double>(n);
+        }
+        return total / dims;
+    }
+
+    void computeInertia(const T *data, size_t n)
+    {
+        const size_t workers = parallel_workers(n, numThreads);
+        std::vector<double> partial(workers, 0.0);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    partial[worker] += squared_distance(data + i * dims, centroid(labels[i]), dims);
+                }
+            },
+            numThreads);
+        inertia = std::accumulate(partial.begin(), partial.end(), 0.0);
+    }
+
+    void checkInput(size_t n, size_t d) const
+    {
+        if (n == 0 || d == 0)
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        if (n < numClusters)
+        {
+            throw std::invalid_argument("Number of samples is smaller than the number of clusters");
+        }
+    }
+
+public:
+    KMeans(size_t num_clusters, size_t max_iterations = 300, double tol = 1e-4, uint64_t random_seed = 0, size_t num_threads = 0)
+        : numClusters(num_clusters), maxIterations(max_iterations), tolerance(tol), seed(random_seed), numThreads(num_threads)
+    {
+        if (numClusters < 1)
+        {
+            throw std::invalid_argument("Number of clusters must be at least 1");
+        }
+    }
+
+    // data: n rows of d values, row-major and contiguous
+    void fit(const T *data, size_t n, size_t d)
+    {
+        checkInput(n, d);
+        dims = d;
+        std::mt19937_64 rng(seed);
+        seedPlusPlus(data, n, rng);
+
+        labels.assign(n, 0);
+        std::vector<double> upper(n), lower(n);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    double best, second;
+                    nearestTwo(data + i * dims, labels[i], best, second);
+                    upper[i] = std::sqrt(best);
+                    lower[i] = std::sqrt(second);
+                }
+            },
+            numThreads);
+
+        const double threshold = tolerance * meanVariance(data, n);
+        std::vector<double> halfGap(numClusters), shift(numClusters);
+
+        for (iterationsRun = 1; iterationsRun <= maxIterations; ++iterationsRun)
+        {
+            std::vector<T> updated = computeCentroids(data, n);
+
+            double totalShift = 0.0, maxShift = 0.0, secondShift = 0.0;
+            size_t maxShiftCluster = 0;
+            for (size_t c = 0; c < numClusters; ++c)
+            {
+                const double moved = squared_distance(&updated[c * dims], centroid(c), dims);
+                totalShift += moved;
+                shift[c] = std::sqrt(moved);
+                if (shift[c] > maxShift)
+                {
+                    secondShift = maxShift;
+                    maxShift = shift[c];
+                    maxShiftCluster = c;
+                }
+                else if (shift[c] > secondShift)
+                {
+                    secondShift = shift[c];
+                }
+            }
+            centroids = std::move(updated);
+
+            // s(c): half the distance to the closest other centre
+            for (size_t c = 0; c < numClusters; ++c)
+            {
+                double closest = std::numeric_limits<double>::infinity();
+                for (size_t o = 0; o < numClusters; ++o)
+                {
+                    if (o != c)
+                    {
+                        closest = std::min<double>(closest, squared_distance(centroid(c), centroid(o), dims));
+                    }
+                }
+                halfGap[c] = 0.5 * std::sqrt(closest);
+            }
+
+            const size_t workers = parallel_workers(n, numThreads);
+            std::vector<size_t> changed(workers, 0);
+            parallel_for(
+                n,
+                [&](size_t begin, size_t end, size_t worker)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const uint32_t assigned = labels[i];
+                        upper[i] += shift[assigned];
+                        lower[i] -= assigned == maxShiftCluster ? secondShift : maxShift;
+
+                        const double bound = std::max(halfGap[assigned], lower[i]);
+                        if (upper[i] <= bound)
+                        {
+                            continue;
+                        }
+                        upper[i] = std::sqrt(squared_distance(data + i * dims, centroid(assigned), dims));
+                        if (upper[i] <= bound)
+                        {
+                            continue;
+                        }
+
+                        double best, second;
+                        nearestTwo(data + i * dims, labels[i], best, second);
+                        upper[i] = std::sqrt(best);
+                        lower[i] = std::sqrt(second);
+                        changed[worker] += labels[i] != assigned;
+                    }
+                },
+                numThreads);
+
+            if (std::accumulate(changed.begin(), changed.end(), size_t(0)) == 0 || totalShift <= threshold)
+            {
+                break;
+            }
+        }
+        iterationsRun = std::min(iterationsRun, maxIterations);
+        computeInertia(data, n);
+    }
+
+    void fit(const std::vector<std::vector<T>> &rows)
+    {
+        if (rows.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        std::vector<T> flat;
+        flat.reserve(rows.size() * rows[0].size());
+        for (const auto &row : rows)
+        {
+            if (row.size() != rows[0].size())
+            {
+                throw std::invalid_argument("Inconsistent number of features in input data");
+            }
+            flat.insert(flat.end(), row.begin(), row.end());
+        }
+        fit(flat.data(), rows.size(), rows[0].size());
+    }
+
+    // Mini-batch k-means: k-means++ on a sample, then `iterations` steps that
+    // each assign batch_size random rows and move every centre towards the
+    // mean of its batch points with a per-centre learning rate 1 / count
+    void fitMiniBatch(const T *data, size_t n, size_t d, size_t batch_size = 1024, size_t iterations = 100)
+    {
+        checkInput(n, d);
+        dims = d;
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+
+        const size_t sampleSize = std::min(n, std::max(batch_size, 3 * numClusters));
+        std::vector<T> sample(sampleSize * dims);
+        for (size_t s = 0; s < sampleSize; ++s)
+        {
+            const size_t row = sampleSize == n ? s : pick(rng);
+            std::copy(data + row * dims, data + row * dims + dims, sample.begin() + s * dims);
+        }
+        seedPlusPlus(sample.data(), sampleSize, rng);
+
+        std::vector<double> counts(numClusters, 0.0);
+        std::vector<size_t> batch(batch_size);
+        std::vector<uint32_t> batchLabels(batch_size);
+        std::vector<double> sums(numClusters * dims);
+        std::vector<double> batchCounts(numClusters);
+
+        for (iterationsRun = 1; iterationsRun <= iterations; ++iterationsRun)
+        {
+            for (auto &row : batch)
+            {
+                row = pick(rng);
+            }
+            parallel_for(
+                batch_size,
+                [&](size_t begin, size_t end, size_t)
+                {
+                    for (size_t b = begin; b < end; ++b)
+                    {
+                        double best, second;
+                        nearestTwo(data + batch[b] * dims, batchLabels[b], best, second);
+                    }
+                },
+                numThreads, 256);
+
+            std::fill(sums.begin(), sums.end(), 0.0);
+            std::fill(batchCounts.begin(), batchCounts.end(), 0.0);
+            for (size_t b = 0; b < batch_size; ++b)
+            {
+                const T *point = data + batch[b] * dims;
+                double *sum = &sums[batchLabels[b] * dims];
+                for (size_t j = 0; j < dims; ++j)
+                {
+                    sum[j] += point[j];
+                }
+                batchCounts[batchLabels[b]] += 1.0;
+            }
+
+            for (size_t c = 0; c < numClusters; ++c)
+            {
+                if (batchCounts[c] == 0.0)
+                {
+                    continue;
+                }
+                counts[c] += batchCounts[c];
+                const double rate = 1.0 / counts[c];
+                for (size_t j = 0; j < dims; ++j)
+                {
+                    const double current = centroids[c * dims + j];
+                    centroids[c * dims + j] = static_cast<T>(current * (1.0 - batchCounts[c] * rate) + sums[c * dims + j] * rate);
+                }
+            }
+        }
+        iterationsRun = iterations;
+
+        labels = predict(data, n);
+        computeInertia(data, n);
+    }
+
+    std::vector<uint32_t> predict(const T *data, size_t n) const
+    {
+        if (centroids.empty())
+        {
+            throw std::logic_error("KMeans has not been fitted. Call fit method first.");
+        }
+
+        std::vector<uint32_t> result(n);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    double best, second;
+                    nearestTwo(data + i * dims, result[i], best, second);
+                }
+            },
+            numThreads);
+        return result;
+    }
+
+    const std::vector<T> &getCentroids() const { return centroids; }
+    const std::vector<uint32_t> &getLabels() const { return labels; }
+    double getInertia() const { return inertia; }
+    size_t getIterations() const { return iterationsRun; }
+    size_t getDimensions() const { return dims; }
+};
@@ -0,0 +1,623 @@
+#pragma once
+
+#include "include_file.h"
+#include "Serialization.h"
+#include "StringDictionary.h"
+
+// Columnar on-disk format for feature tables, read through mmap.
+//
+// Layout (offsets from the start of the file):
+//   object header (SerialKind::ColumnTable)
+//   column 0 values | column 1 values | ...   each starting on a 64-byte boundary
+//   directory                                 row count, chunk size, one entry per column
+//   u64 directory offset | "MLCTFOOT"
+// A column holds raw native values (float, double, int32, int64) or, for
+// strings, uint32 dictionary codes whose StringDictionary sits in the
+// directory. Columns are cut into chunks of chunkSize() rows, a multiple of
+// 64, so every chunk starts 64-byte aligned and the chunks of a column are
+// back to back: a whole column is a single view.
+//
+// Every chunk records rows / null count / min / max. A scan can skip chunks
+// whose range cannot match (chunkMayContain), and columnStats gives a column's
+// extremes and null count straight from the directory, without reading the
+// values. The scalers and imputers take row-major rows and have no ColumnTable
+// entry point, so a caller applies these itself (examples/ColumnTable.cpp
+// min-max scales a column from columnStats). NaN is the null of
+// floating-point columns (as in SimpleImputer), column_null_code that of
+// string columns; integer columns have no nulls.
+//
+// ColumnTableWriter streams: it buffers one chunk, so tables larger than
+// memory are written column by column. ColumnTable::open reads only the
+// directory and hands out FlatArray views of the mapping, so reading a column
+// costs its page faults and nothing else. Same trust model as Serialization.h:
+// structure is validated, contents are not.
+
+struct ColumnChunkStats
+{
+    uint64_t rows;
+    uint64_t nullCount;
+    double min; // +inf / -inf when every value is null
+    double max; // int64 extremes are rounded outwards, so skipping stays safe
+};
+
+constexpr uint32_t column_null_code = StringDictionary::npos;
+
+// Bytes per stored value; 0 for types a column cannot have
+inline size_t column_element_size(SerialType type)
+{
+    switch (type)
+    {
+    case SerialType::Float32:
+    case SerialType::Int32:
+    case SerialType::String:
+        return 4;
+    case SerialType::Float64:
+    case SerialType::Int64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+// Nearest double at or below / at or above a statistic
+template <typename T>
+double column_stat_floor(T value)
+{
+    double bound = static_cast<double>(value);
+    if constexpr (std::is_integral_v<T>)
+    {
+        if (bound >= 0x1p63 || static_cast<T>(bound) > value)
+        {
+            bound = std::nextafter(bound, -std::numeric_limits<double>::infinity());
+        }
+    }
+    return bound;
+}
+
+template <typename T>
+double column_stat_ceil(T value)
+{
+    double bound = static_cast<double>(value);
+    if constexpr (std::is_integral_v<T>)
+    {
+        if (bound < 0x1p63 && static_cast<T>(bound) < value)
+        {
+            bound = std::nextafter(bound, std::numeric_limits<double>::infinity());
+        }
+    }
+    return bound;
+}
+
+class ColumnTableWriter
+{
+private:
+    struct Column
+    {
+        std::string name;
+        SerialType type = SerialType::None;
+        uint64_t offset = 0;
+        uint64_t rows = 0;
+        std::vector<ColumnChunkStats> stats;
+        StringDictionary dictionary;
+    };
+
+    static constexpr size_t alignment = 64;
+
+    std::string path;
+    std::string temporary;
+    std::ofstream stream;
+    size_t chunkRows;
+    uint64_t written = 0;
+    std::vector<Column> columns;
+    bool columnOpen = false;
+    bool finished = false;
+    std::vector<char> pending; // values of the chunk being filled
+    size_t pendingRows = 0;
+    ColumnChunkStats pendingStats{};
+
+    static ColumnChunkStats emptyStats()
+    {
+        return ColumnChunkStats{0, 0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    }
+
+    void writeBytes(const char *bytes, size_t n)
+    {
+        stream.write(bytes, static_cast<std::streamsize>(n));
+        if (!stream)
+        {
+            throw std::runtime_error("Cannot write " + temporary);
+        }
+        written += n;
+    }
+
+    void padTo(size_t boundary)
+    {
+        static const char zeros[alignment] = {};
+        writeBytes(zeros, (boundary - written % boundary) % boundary);
+    }
+
+    Column &current(SerialType type)
+    {
+        if (!columnOpen)
+        {
+            throw std::logic_error("beginColumn() must be called before appending values");
+        }
+        if (columns.back().type != type)
+        {
+            throw std::invalid_argument("Values do not match the type of column " + columns.back().name);
+        }
+        return columns.back();
+    }
+
+    void flushChunk()
+    {
+        if (pendingRows == 0)
+        {
+            return;
+        }
+        writeBytes(pending.data(), pendingRows * column_element_size(columns.back().type));
+        columns.back().stats.push_back(pendingStats);
+        pendingRows = 0;
+        pendingStats = emptyStats();
+    }
+
+    // V is the stored type: the column's value type, or uint32_t codes
+    template <typename V>
+    void appendStored(const V *values, size_t n)
+    {
+        Column &column = columns.back();
+        for (size_t done = 0; done < n;)
+        {
+            const size_t count = std::min(n - done, chunkRows - pendingRows);
+            const V *chunk = values + done;
+            std::memcpy(pending.data() + pendingRows * sizeof(V), chunk, count * sizeof(V));
+
+            V low = std::numeric_limits<V>::max();
+            V high = std::numeric_limits<V>::lowest();
+            size_t nulls = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const V value = chunk[i];
+                bool isNull = false;
+                if constexpr (std::is_floating_point_v<V>)
+                {
+                    isNull = std::isnan(value);
+                }
+                else if constexpr (std::is_same_v<V, uint32_t>)
+                {
+                    isNull = value == column_null_code;
+                }
+                if (isNull)
+                {
+                    ++nulls;
+                    continue;
+                }
+                low = std::min(low, value);
+                high = std::max(high, value);
+            }
+            pendingStats.rows += count;
+            pendingStats.nullCount += nulls;
+            if (nulls < count)
+            {
+                pendingStats.min = std::min(pendingStats.min, column_stat_floor(low));
+                pendingStats.max = std::max(pendingStats.max, column_stat_ceil(high));
+            }
+
+            pendingRows += count;
+            column.rows += count;
+            done += count;
+            if (pendingRows == chunkRows)
+            {
+                flushChunk();
+            }
+        }
+    }
+
+    template <typename V>
+    void appendRepeated(V value, size_t n)
+    {
+        V block[256];
+        std::fill(block, block + 256, value);
+        for (size_t done = 0; done < n; done += 256)
+        {
+            appendStored(block, std::min<size_t>(256, n - done));
+        }
+    }
+
+public:
+    // chunk_rows is rounded up to a multiple of 64
+    explicit ColumnTableWriter(const std::string &output_path, size_t chunk_rows = 65536)
+        : path(output_path), temporary(output_path + ".tmp"), stream(temporary, std::ios::binary | std::ios::trunc),
+          chunkRows((std::max<size_t>(chunk_rows, 1) + alignment - 1) / alignment * alignment)
+    {
+        if (!stream)
+        {
+            throw std::runtime_error("Cannot write " + temporary);
+        }
+        BinaryWriter header;
+        header.writeHeader(SerialKind::ColumnTable, SerialType::None);
+        writeBytes(header.buffer().data(), header.buffer().size());
+    }
+
+    ColumnTableWriter(const ColumnTableWriter &) = delete;
+    ColumnTableWriter &operator=(const ColumnTableWriter &) = delete;
+
+    // An unfinished table never replaces path
+    ~ColumnTableWriter()
+    {
+        if (!finished)
+        {
+            stream.close();
+            std::remove(temporary.c_str());
+        }
+    }
+
+    void beginColumn(const std::string &name, SerialType type)
+    {
+        if (finished || columnOpen)
+        {
+            throw std::logic_error(finished ? "The table is already finished" : "endColumn() must be called before the next column");
+        }
+        if (column_element_size(type) == 0)
+        {
+            throw std::invalid_argument("Columns hold float, double, int32, int64 or strings");
+        }
+        for (const Column &column : columns)
+        {
+            if (column.name == name)
+            {
+                throw std::invalid_argument("Duplicate column " + name);
+            }
+        }
+        padTo(alignment);
+        columns.emplace_back();
+        columns.back().name = name;
+        columns.back().type = type;
+        columns.back().offset = written;
+        pending.resize(chunkRows * column_element_size(type));
+        pendingRows = 0;
+        pendingStats = emptyStats();
+        columnOpen = true;
+    }
+
+    template <typename T>
+    void append(const T *values, size_t n)
+    {
+        static_assert(std::is_arithmetic_v<T> && serial_type<T>() != SerialType::None,
+                      "Numeric columns hold float, double, int32 or int64");
+        current(serial_type<T>());
+        appendStored(values, n);
+    }
+
+    // Dictionary-encodes keys (any type convertible to std::string_view)
+    template <typename Key>
+    void appendStrings(const Key *keys, size_t n)
+    {
+        Column &column = current(SerialType::String);
+        uint32_t codes[256];
+        for (size_t first = 0; first < n; first += 256)
+        {
+            const size_t count = std::min<size_t>(256, n - first);
+            for (size_t j = 0; j < count; ++j)
+            {
+                codes[j] = column.dictionary.insert(std::string_view(keys[first + j]));
+            }
+            appendStored(codes, count);
+        }
+    }
+
+    void appendNulls(size_t n)
+    {
+        if (!columnOpen)
+        {
+            throw std::logic_error("beginColumn() must be called before appending values");
+        }
+        switch (columns.back().type)
+        {
+        case SerialType::Float32:
+            appendRepeated(std::numeric_limits<float>::quiet_NaN(), n);
+            break;
+        case SerialType::Float64:
+            appendRepeated(std::numeric_limits<double>::quiet_NaN(), n);
+            break;
+        case SerialType::String:
+            appendRepeated(column_null_code, n);
+            break;
+        default:
+            throw std::invalid_argument("Integer column " + columns.back().name + " cannot hold nulls");
+        }
+    }
+
+    void endColumn()
+    {
+        if (!columnOpen)
+        {
+            throw std::logic_error("No column is open");
+        }
+        const Column &column = columns.back();
+        if (column.rows != columns.front().rows)
+        {
+            throw std::invalid_argument("Column " + column.name + " has " + std::to_string(column.rows) + " rows, expected " +
+                                        std::to_string(columns.front().rows));
+        }
+        flushChunk();
+        columnOpen = false;
+    }
+
+    template <typename T>
+    void addColumn(const std::string &name, const std::vector<T> &values)
+    {
+        constexpr SerialType type = serial_type<T>();
+        beginColumn(name, type);
+        if constexpr (type == SerialType::String)
+        {
+            appendStrings(values.data(), values.size());
+        }
+        else
+        {
+            append(values.data(), values.size());
+        }
+        endColumn();
+    }
+
+    // Writes the directory and footer, then renames the file into place
+    void finish()
+    {
+        if (finished || columnOpen)
+        {
+            throw std::logic_error(finished ? "The table is already finished" : "endColumn() must be called before finish()");
+        }
+        padTo(alignment);
+        const uint64_t directoryOffset = written;
+
+        BinaryWriter directory;
+        directory.write<uint64_t>(columns.empty() ? 0 : columns.front().rows);
+        directory.write<uint64_t>(chunkRows);
+        directory.write<uint64_t>(columns.size());
+        for (const Column &column : columns)
+        {
+            directory.writeArray(column.name.data(), column.name.size());
+            directory.write<uint32_t>(static_cast<uint32_t>(column.type));
+            directory.write<uint32_t>(0);
+            directory.write<uint64_t>(column.offset);
+            directory.writeArray(column.stats);
+            if (column.type == SerialType::String)
+            {
+                column.dictionary.save(directory);
+            }
+        }
+        writeBytes(directory.buffer().data(), directory.buffer().size());
+        padTo(8);
+        writeBytes(reinterpret_cast<const char *>(&directoryOffset), sizeof(directoryOffset));
+        writeBytes("MLCTFOOT", 8);
+
+        stream.close();
+        if (!stream)
+        {
+            throw std::runtime_error("Cannot write " + temporary);
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            throw std::runtime_error("Cannot rename " + temporary + " to " + path);
+        }
+        finished = true;
+    }
+};
+
+class ColumnTable
+{
+private:
+    struct Column
+    {
+        std::string name;
+        SerialType type;
+        uint64_t offset;
+        FlatArray<ColumnChunkStats> stats;
+        StringDictionary dictionary;
+    };
+
+    std::shared_ptr<const MappedFile> file;
+    size_t numRows = 0;
+    size_t chunkRows = 0;
+    std::vector<Column> columns;
+
+    ColumnTable() = default;
+
+    const Column &entry(size_t column) const
+    {
+        if (column >= columns.size())
+        {
+            throw std::out_of_range("Column index " + std::to_string(column) + " is out of range");
+        }
+        return columns[column];
+    }
+
+    // T is the column's value type, or uint32_t for the codes of a string column
+    template <typename T>
+    const Column &typed(size_t column) const
+    {
+        const Column &found = entry(column);
+        const SerialType expected = std::is_same_v<T, uint32_t> ? SerialType::String : serial_type<T>();
+        if (found.type != expected)
+        {
+            throw std::invalid_argument("Column " + found.name + " is not of the requested type");
+        }
+        return found;
+    }
+
+public:
+    static ColumnTable open(const std::string &path)
+    {
+        return load(MappedFile::open(path));
+    }
+
+    static ColumnTable load(std::shared_ptr<const MappedFile> source)
+    {
+        ColumnTable table;
+        table.file = source;
+        BinaryReader reader(source);
+        reader.readHeader(SerialKind::ColumnTable, SerialType::None);
+        const size_t dataStart = reader.tell();
+
+        if (source->size() < dataStart + 16 || std::memcmp(source->data() + source->size() - 8, "MLCTFOOT", 8) != 0)
+        {
+            throw std::runtime_error("Column table has no footer (truncated or unfinished write)");
+        }
+        uint64_t directoryOffset;
+        std::memcpy(&directoryOffset, source->data() + source->size() - 16, sizeof(directoryOffset));
+        if (directoryOffset < dataStart || directoryOffset > source->size() - 16)
+        {
+            throw std::runtime_error("Corrupt column table directory offset");
+        }
+        reader.seek(directoryOffset);
+
+        table.numRows = reader.read<uint64_t>();
+        table.chunkRows = reader.read<uint64_t>();
+        const uint64_t numColumns = reader.read<uint64_t>();
+        if (table.numRows > source->size() || table.chunkRows == 0 || table.chunkRows % 64 != 0)
+        {
+            throw std::runtime_error("Corrupt column table directory");
+        }
+        for (uint64_t c = 0; c < numColumns; ++c)
+        {
+            Column column;
+            const FlatArray<char> name = reader.readArray<char>();
+            column.name.assign(name.begin(), name.end());
+            column.type = static_cast<SerialType>(reader.read<uint32_t>());
+            reader.read<uint32_t>();
+            column.offset = reader.read<uint64_t>();
+            column.stats = reader.readArray<ColumnChunkStats>();
+
+            const size_t width = column_element_size(column.type);
+            if (width == 0 || column.stats.size() != table.numChunks() || column.offset % 64 != 0 || column.offset < dataStart ||
+                column.offset > directoryOffset || table.numRows > (directoryOffset - column.offset) / width)
+            {
+                throw std::runtime_error("Corrupt column table entry for column " + column.name);
+            }
+            if (column.type == SerialType::String)
+            {
+                column.dictionary = StringDictionary::load(reader);
+            }
+            table.columns.push_back(std::move(column));
+        }
+        return table;
+    }
+
+    size_t rows() const
+    {
+        return numRows;
+    }
+
+    size_t chunkSize() const
+    {
+        return chunkRows;
+    }
+
+    size_t numChunks() const
+    {
+        return (numRows + chunkRows - 1) / chunkRows;
+    }
+
+    size_t numColumns() const
+    {
+        return columns.size();
+    }
+
+    const std::string &columnName(size_t column) const
+    {
+        return entry(column).name;
+    }
+
+    SerialType columnType(size_t column) const
+    {
+        return entry(column).type;
+    }
+
+    size_t columnIndex(const std::string &name) const
+    {
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            if (columns[c].name == name)
+            {
+                return c;
+            }
+        }
+        throw std::out_of_range("No column named " + name);
+    }
+
+    // Zero-copy view of a whole column
+    template <typename T>
+    FlatArray<T> column(size_t column) const
+    {
+        const Column &found = typed<T>(column);
+        return FlatArray<T>::viewOf(reinterpret_cast<const T *>(file->data() + found.offset), numRows, file);
+    }
+
+    template <typename T>
+    FlatArray<T> column(const std::string &name) const
+    {
+        return column<T>(columnIndex(name));
+    }
+
+    template <typename T>
+    FlatArray<T> chunk(size_t column, size_t chunk) const
+    {
+        const Column &found = typed<T>(column);
+        if (chunk >= numChunks())
+        {
+            throw std::out_of_range("Chunk " + std::to_string(chunk) + " is out of range");
+        }
+        const size_t first = chunk * chunkRows;
+        return FlatArray<T>::viewOf(reinterpret_cast<const T *>(file->data() + found.offset) + first,
+                                    std::min(chunkRows, numRows - first), file);
+    }
+
+    const ColumnChunkStats &chunkStats(size_t column, size_t chunk) const
+    {
+        const Column &found = entry(column);
+        if (chunk >= numChunks())
+        {
+            throw std::out_of_range("Chunk " + std::to_string(chunk) + " is out of range");
+        }
+        return found.stats[chunk];
+    }
+
+    // Chunk statistics merged over the whole column
+    ColumnChunkStats columnStats(size_t column) const
+    {
+        ColumnChunkStats merged{0, 0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+        for (const ColumnChunkStats &stats : entry(column).stats)
+        {
+            merged.rows += stats.rows;
+            merged.nullCount += stats.nullCount;
+            merged.min = std::min(merged.min, stats.min);
+            merged.max = std::max(merged.max, stats.max);
+        }
+        return merged;
+    }
+
+    // False only when no non-null value of the chunk can lie in [low, high]
+    bool chunkMayContain(size_t column, size_t chunk, double low, double high) const
+    {
+        const ColumnChunkStats &stats = chunkStats(column, chunk);
+        return stats.nullCount < stats.rows && stats.max >= low && stats.min <= high;
+    }
+
+    const StringDictionary &dictionary(size_t column) const
+    {
+        const Column &found = typed<uint32_t>(column);
+        return found.dictionary;
+    }
+
+    // Empty for a null entry
+    std::string_view stringAt(size_t column, size_t row) const
+    {
+        const Column &found = typed<uint32_t>(column);
+        if (row >= numRows)
+        {
+            throw std::out_of_range("Row " + std::to_string(row) + " is out of range");
+        }
+        const uint32_t code = reinterpret_cast<const uint32_t *>(file->data() + found.offset)[row];
+        return code == column_null_code ? std::string_view() : found.dictionary.at(code);
+    }
+};
@@ -0,0 +1,650 @@
+#pragma once
+
+#include "include_file.h"
+#include "Parallel.h"
+#include "Serialization.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Parallel CSV reader producing contiguous columns.
+//
+// The input (mmap'd via MappedFile, or an in-memory string) goes through
+// three parallel passes over byte ranges:
+//   1. each range counts its quotes and finds its first newline under both
+//      possible quote states; a prefix over the ranges then knows the real
+//      state at every range start, so records are split at newlines that are
+//      really outside quotes (a quoted field may contain newlines)
+//   2. each record range counts its records, giving every range its first
+//      output row
+//   3. each record range parses straight into the preallocated columns
+// Delimiters, quotes and newlines are found 64 bytes at a time: one
+// comparison mask per character class (AVX2 when available) and a prefix XOR
+// over the quote mask that marks quoted bytes, so the scalar code only visits
+// structural characters. Numbers are parsed with std::from_chars.
+//
+// Empty numeric fields become NaN, the missing-value marker of SimpleImputer.
+// Columns named in setStringColumns() are kept as text for the encoders.
+// RFC 4180 quoting ("" inside a quoted field), CRLF line ends, a UTF-8 BOM
+// and blank lines are accepted. A record with the wrong number of fields or
+// a non-numeric value in a numeric column throws std::runtime_error naming
+// the record.
+
+// Bit i set when byte i of the 64-byte block p equals c
+inline uint64_t csv_match_mask(const char *p, char c)
+{
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi8(c);
+    const uint32_t low = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), needle)));
+    const uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32)), needle)));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#else
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        mask |= static_cast<uint64_t>(p[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i set when an odd number of bits at or below i are set in x
+inline uint64_t csv_prefix_xor(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Clinger's fast path for plain decimals ("-12.5", "0.001"): when the digits
+// fit T's mantissa exactly and the power of ten is exact in T, one division
+// is correctly rounded. Anything else (exponents, long mantissas, inf, nan)
+// returns false and goes to std::from_chars.
+template <typename T>
+inline bool csv_parse_plain_decimal(const char *first, const char *last, T &value)
+{
+    static constexpr double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int maxPower = std::is_same_v<T, float> ? 10 : 22;
+    constexpr uint64_t maxMantissa = uint64_t(1) << std::numeric_limits<T>::digits;
+
+    const bool negative = first < last && *first == '-';
+    const char *p = first + (negative ? 1 : 0);
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int fraction = 0;
+    for (; p < last && static_cast<unsigned>(*p - '0') < 10; ++p, ++digits)
+    {
+        mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+    }
+    if (p < last && *p == '.')
+    {
+        for (++p; p < last && static_cast<unsigned>(*p - '0') < 10; ++p, ++digits, ++fraction)
+        {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+        }
+    }
+    if (p != last || digits == 0 || digits > 19 || fraction > maxPower || mantissa > maxMantissa)
+    {
+        return false;
+    }
+    value = static_cast<T>(mantissa) / static_cast<T>(powers[fraction]);
+    value = negative ? -value : value;
+    return true;
+}
+
+// Value of a number std::from_chars parsed whole but reported as
+// result_out_of_range: that only happens when it rounds to 0 or +-inf, so,
+// like strtod, underflow gives a signed 0 and overflow a signed infinity,
+// told apart by the decimal exponent of the first significant digit.
+template <typename T>
+inline T csv_out_of_range_value(const char *first, const char *last)
+{
+    const bool negative = first < last && *first == '-';
+    const char *p = first + (negative ? 1 : 0);
+    int64_t exponent = -1;
+    bool significant = false, fraction = false;
+    for (; p < last && *p != 'e' && *p != 'E'; ++p)
+    {
+        if (*p == '.')
+        {
+            fraction = true;
+            continue;
+        }
+        significant = significant || *p != '0';
+        if (!significant && fraction)
+        {
+            --exponent;
+        }
+        else if (significant && !fraction)
+        {
+            ++exponent;
+        }
+    }
+    if (p < last)
+    {
+        ++p;
+        const bool negativeExponent = p < last && *p == '-';
+        p += p < last && (*p == '-' || *p == '+') ? 1 : 0;
+        int64_t written = 0;
+        for (; p < last; ++p)
+        {
+            written = std::min<int64_t>(written * 10 + (*p - '0'), int64_t(1) << 40);
+        }
+        exponent += negativeExponent ? -written : written;
+    }
+    const T magnitude = exponent >= 0 ? std::numeric_limits<T>::infinity() : T(0);
+    return negative ? -magnitude : magnitude;
+}
+
+// Walks the unquoted delimiters and newlines of [begin, end), which must
+// start outside quotes. With newlines_only, delimiters are not reported.
+class CsvScanner
+{
+private:
+    const char *block;
+    const char *end;
+    char delimiter;
+    char quote;
+    bool newlinesOnly;
+    uint64_t structural = 0;
+    uint64_t inQuote = 0; // all ones while the previous block ended inside quotes
+    char tail[64];
+
+    void load()
+    {
+        const char *bytes = block;
+        if (end - block < 64)
+        {
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, block, static_cast<size_t>(end - block));
+            bytes = tail;
+        }
+        const uint64_t quoted = csv_prefix_xor(csv_match_mask(bytes, quote)) ^ inQuote;
+        inQuote = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+        uint64_t candidates = csv_match_mask(bytes, '\n');
+        if (!newlinesOnly)
+        {
+            candidates |= csv_match_mask(bytes, delimiter);
+        }
+        structural = candidates & ~quoted;
+    }
+
+public:
+    CsvScanner(const char *begin, const char *stop, char field_delimiter, char quote_char, bool newlines_only = false)
+        : block(begin), end(stop), delimiter(field_delimiter), quote(quote_char), newlinesOnly(newlines_only)
+    {
+        if (block < end)
+        {
+            load();
+        }
+    }
+
+    // Next structural character, or nullptr at the end of the range
+    const char *next()
+    {
+        while (structural == 0)
+        {
+            if (end - block <= 64)
+            {
+                return nullptr;
+            }
+            block += 64;
+            load();
+        }
+        const char *at = block + __builtin_ctzll(structural);
+        structural &= structural - 1;
+        return at;
+    }
+};
+
+// Parsed table: one contiguous vector per numeric column, strings for the
+// columns requested as text
+template <typename T = double>
+class CsvColumns
+{
+    template <typename>
+    friend class CsvReader;
+
+private:
+    std::vector<std::string> names;
+    std::vector<bool> text;
+    std::vector<std::vector<T>> numeric;
+    std::vector<std::vector<std::string>> strings;
+    size_t numRows = 0;
+
+public:
+    size_t rows() const
+    {
+        return numRows;
+    }
+
+    size_t numColumns() const
+    {
+        return names.size();
+    }
+
+    const std::vector<std::string> &columnNames() const
+    {
+        return names;
+    }
+
+    size_t columnIndex(const std::string &name) const
+    {
+        const auto found = std::find(names.begin(), names.end(), name);
+        if (found == names.end())
+        {
+            throw std::out_of_range("No column named " + name);
+        }
+        return static_cast<size_t>(found - names.begin());
+    }
+
+    bool isText(size_t column) const
+    {
+        return text.at(column);
+    }
+
+    const std::vector<T> &column(size_t column) const
+    {
+        if (isText(column))
+        {
+            throw std::invalid_argument("Column " + names[column] + " was read as text");
+        }
+        return numeric[column];
+    }
+
+    const std::vector<T> &column(const std::string &name) const
+    {
+        return column(columnIndex(name));
+    }
+
+    const std::vector<std::string> &stringColumn(size_t column) const
+    {
+        if (!isText(column))
+        {
+            throw std::invalid_argument("Column " + names[column] + " was read as numbers");
+        }
+        return strings[column];
+    }
+
+    const std::vector<std::string> &stringColumn(const std::string &name) const
+    {
+        return stringColumn(columnIndex(name));
+    }
+
+    // Numeric columns as rows, the layout FeatureScaler and SimpleImputer take
+    std::vector<std::vector<T>> toRows() const
+    {
+        std::vector<size_t> selected;
+        for (size_t c = 0; c < names.size(); ++c)
+        {
+            if (!text[c])
+            {
+                selected.push_back(c);
+            }
+        }
+        std::vector<std::vector<T>> rowMajor(numRows, std::vector<T>(selected.size()));
+        for (size_t k = 0; k < selected.size(); ++k)
+        {
+            const std::vector<T> &values = numeric[selected[k]];
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                rowMajor[i][k] = values[i];
+            }
+        }
+        return rowMajor;
+    }
+};
+
+template <typename T = double>
+class CsvReader
+{
+    static_assert(std::is_floating_point_v<T>, "CsvReader parses into float or double columns");
+
+private:
+    char delimiter;
+    char quote;
+    bool hasHeader;
+    size_t numThreads;
+    std::vector<std::string> textColumns;
+
+    static constexpr size_t minRangeBytes = size_t(1) << 20;
+
+    // Field text without surrounding quotes, "" unescaped
+    std::string unquote(const char *first, const char *last) const
+    {
+        if (last - first >= 2 && *first == quote && last[-1] == quote)
+        {
+            std::string value;
+            value.reserve(static_cast<size_t>(last - first - 2));
+            for (const char *p = first + 1; p < last - 1; ++p)
+            {
+                value.push_back(*p);
+                if (*p == quote && p + 1 < last - 1 && p[1] == quote)
+                {
+                    ++p;
+                }
+            }
+            return value;
+        }
+        return std::string(first, last);
+    }
+
+    bool parseNumber(const char *first, const char *last, T &value) const
+    {
+        while (first < last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        while (last > first && (last[-1] == ' ' || last[-1] == '\t'))
+        {
+            --last;
+        }
+        if (last - first >= 2 && *first == quote && last[-1] == quote)
+        {
+            ++first;
+            --last;
+        }
+        if (first == last)
+        {
+            value = std::numeric_limits<T>::quiet_NaN();
+            return true;
+        }
+        if (*first == '+')
+        {
+            ++first;
+        }
+        if (csv_parse_plain_decimal(first, last, value))
+        {
+            return true;
+        }
+        const std::from_chars_result result = std::from_chars(first, last, value);
+        if (result.ec == std::errc::result_out_of_range && result.ptr == last)
+        {
+            value = csv_out_of_range_value<T>(first, last);
+            return true;
+        }
+        return result.ec == std::errc() && result.ptr == last;
+    }
+
+    // Fields of the record starting at begin; returns the start of the next record
+    const char *splitRecord(const char *begin, const char *end, std::vector<std::string> &fields) const
+    {
+        CsvScanner scanner(begin, end, delimiter, quote);
+        const char *fieldStart = begin;
+        for (const char *at = scanner.next();; at = scanner.next())
+        {
+            const char *fieldEnd = at == nullptr ? end : at;
+            const bool recordEnd = at == nullptr || *at == '\n';
+            if (recordEnd && fieldEnd > fieldStart && fieldEnd[-1] == '\r')
+            {
+                --fieldEnd;
+            }
+            fields.push_back(unquote(fieldStart, fieldEnd));
+            if (recordEnd)
+            {
+                return at == nullptr ? end : at + 1;
+            }
+            fieldStart = at + 1;
+        }
+    }
+
+    static bool isBlank(const char *first, const char *last)
+    {
+        return first == last || (last - first == 1 && *first == '\r');
+    }
+
+    size_t countRecords(const char *begin, const char *end) const
+    {
+        CsvScanner scanner(begin, end, delimiter, quote, true);
+        size_t count = 0;
+        const char *recordStart = begin;
+        for (const char *at = scanner.next(); at != nullptr; at = scanner.next())
+        {
+            count += isBlank(recordStart, at) ? 0 : 1;
+            recordStart = at + 1;
+        }
+        return count + (isBlank(recordStart, end) ? 0 : 1);
+    }
+
+    [[noreturn]] static void throwNumberError(const CsvColumns<T> &table, size_t column, size_t row, const char *first, const char *last)
+    {
+        throw std::runtime_error("CSV record " + std::to_string(row) + ", column " + table.names[column] +
+                                 ": cannot parse '" + std::string(first, last) + "' as a number");
+    }
+
+    // numbers[column] is the numeric column's data, nullptr for text columns
+    void storeField(CsvColumns<T> &table, T *const *numbers, size_t column, size_t row, const char *first, const char *last) const
+    {
+        if (numbers[column] == nullptr)
+        {
+            table.strings[column][row] = unquote(first, last);
+        }
+        else if (!parseNumber(first, last, numbers[column][row]))
+        {
+            throwNumberError(table, column, row, first, last);
+        }
+    }
+
+    void parseRecords(const char *begin, const char *end, size_t firstRow, CsvColumns<T> &table) const
+    {
+        const size_t expected = table.names.size();
+        std::vector<T *> numbers(expected, nullptr);
+        for (size_t c = 0; c < expected; ++c)
+        {
+            numbers[c] = table.text[c] ? nullptr : table.numeric[c].data();
+        }
+        CsvScanner scanner(begin, end, delimiter, quote);
+        size_t row = firstRow;
+        size_t field = 0;
+        const char *fieldStart = begin;
+        for (const char *at = scanner.next();; at = scanner.next())
+        {
+            const char *fieldEnd = at == nullptr ? end : at;
+            if (at != nullptr && *at == delimiter)
+            {
+                if (field + 1 >= expected)
+                {
+                    throw std::runtime_error("CSV record " + std::to_string(row) + " has more than " + std::to_string(expected) + " fields");
+                }
+                storeField(table, numbers.data(), field++, row, fieldStart, fieldEnd);
+                fieldStart = at + 1;
+                continue;
+            }
+            // end of a record (newline or end of range)
+            if (fieldEnd > fieldStart && fieldEnd[-1] == '\r')
+            {
+                --fieldEnd;
+            }
+            if (field > 0 || fieldEnd > fieldStart)
+            {
+                if (field + 1 != expected)
+                {
+                    throw std::runtime_error("CSV record " + std::to_string(row) + " has " + std::to_string(field + 1) +
+                                             " fields, expected " + std::to_string(expected));
+                }
+                storeField(table, numbers.data(), field, row, fieldStart, fieldEnd);
+                ++row;
+            }
+            if (at == nullptr)
+            {
+                return;
+            }
+            field = 0;
+            fieldStart = at + 1;
+        }
+    }
+
+public:
+    explicit CsvReader(char field_delimiter = ',', bool has_header = true, size_t num_threads = 0, char quote_char = '"')
+        : delimiter(field_delimiter), quote(quote_char), hasHeader(has_header), numThreads(num_threads)
+    {
+        if (delimiter == quote || delimiter == '\n' || delimiter == '\r' || quote == '\n' || quote == '\r')
+        {
+            throw std::invalid_argument("Delimiter and quote must be distinct and not line breaks");
+        }
+    }
+
+    // Columns (by header name) kept as strings instead of parsed as numbers
+    CsvReader &setStringColumns(std::vector<std::string> names)
+    {
+        textColumns = std::move(names);
+        return *this;
+    }
+
+    CsvColumns<T> read(const std::string &path) const
+    {
+        const std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+        return parse(std::string_view(file->data(), file->size()));
+    }
+
+    CsvColumns<T> parse(std::string_view input) const
+    {
+        const char *data = input.data();
+        const char *end = data + input.size();
+        if (input.size() >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        {
+            data += 3;
+        }
+        while (data < end && (*data == '\n' || *data == '\r'))
+        {
+            ++data;
+        }
+
+        CsvColumns<T> table;
+        std::vector<std::string> firstRecord;
+        const char *afterFirst = splitRecord(data, end, firstRecord);
+        if (data == end)
+        {
+            return table;
+        }
+        if (hasHeader)
+        {
+            table.names = std::move(firstRecord);
+        }
+        else
+        {
+            for (size_t c = 0; c < firstRecord.size(); ++c)
+            {
+                table.names.push_back("column_" + std::to_string(c));
+            }
+        }
+        const char *body = hasHeader ? afterFirst : data;
+
+        table.text.assign(table.names.size(), false);
+        for (const std::string &name : textColumns)
+        {
+            table.text[table.columnIndex(name)] = true;
+        }
+
+        // pass 1: quote parity and first newline per byte range, for both
+        // possible quote states at the range start
+        const size_t bytes = static_cast<size_t>(end - body);
+        const size_t ranges = parallel_workers(bytes, numThreads, minRangeBytes);
+        struct RangeScan
+        {
+            const char *firstNewline[2] = {nullptr, nullptr};
+            bool oddQuotes = false;
+        };
+        std::vector<RangeScan> scans(ranges);
+        auto rangeBegin = [&](size_t r)
+        { return body + bytes / ranges * r; };
+        parallel_for(
+            ranges, [&](size_t first, size_t last, size_t)
+            {
+                for (size_t r = first; r < last; ++r)
+                {
+                    const char *begin = rangeBegin(r);
+                    const char *stop = r + 1 == ranges ? end : rangeBegin(r + 1);
+                    RangeScan &scan = scans[r];
+                    uint64_t inQuote = 0;
+                    char tail[64];
+                    for (const char *block = begin; block < stop; block += 64)
+                    {
+                        const char *window = block;
+                        if (stop - block < 64)
+                        {
+                            std::memset(tail, 0, sizeof(tail));
+                            std::memcpy(tail, block, static_cast<size_t>(stop - block));
+                            window = tail;
+                        }
+                        const uint64_t quoted = csv_prefix_xor(csv_match_mask(window, quote)) ^ inQuote;
+                        inQuote = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+                        const uint64_t newlines = csv_match_mask(window, '\n');
+                        const uint64_t candidates[2] = {newlines & ~quoted, newlines & quoted};
+                        for (int state = 0; state < 2; ++state)
+                        {
+                            if (scan.firstNewline[state] == nullptr && candidates[state] != 0)
+                            {
+                                scan.firstNewline[state] = block + __builtin_ctzll(candidates[state]);
+                            }
+                        }
+                    }
+                    scan.oddQuotes = inQuote != 0;
+                } },
+            numThreads, 1);
+
+        // record ranges start after the first newline outside quotes in each byte range
+        std::vector<const char *> starts{body};
+        bool insideQuotes = false;
+        for (size_t r = 0; r < ranges; ++r)
+        {
+            const char *newline = scans[r].firstNewline[insideQuotes ? 1 : 0];
+            if (r > 0 && newline != nullptr)
+            {
+                starts.push_back(newline + 1);
+            }
+            insideQuotes = insideQuotes != scans[r].oddQuotes;
+        }
+        if (insideQuotes)
+        {
+            throw std::runtime_error("CSV input ends inside a quoted field");
+        }
+        starts.push_back(end);
+        const size_t recordRanges = starts.size() - 1;
+
+        // pass 2: records per range, prefix-summed into first output rows
+        std::vector<size_t> firstRows(recordRanges + 1, 0);
+        parallel_for(
+            recordRanges, [&](size_t first, size_t last, size_t)
+            {
+                for (size_t r = first; r < last; ++r)
+                {
+                    firstRows[r + 1] = countRecords(starts[r], starts[r + 1]);
+                } },
+            numThreads, 1);
+        std::partial_sum(firstRows.begin(), firstRows.end(), firstRows.begin());
+        table.numRows = firstRows.back();
+
+        table.numeric.resize(table.names.size());
+        table.strings.resize(table.names.size());
+        for (size_t c = 0; c < table.names.size(); ++c)
+        {
+            if (table.text[c])
+            {
+                table.strings[c].resize(table.numRows);
+            }
+            else
+            {
+                table.numeric[c].resize(table.numRows);
+            }
+        }
+
+        // pass 3: parse into the columns; parallel_for rethrows the first
+        // failing record's error
+        parallel_for(
+            recordRanges, [&](size_t first, size_t last, size_t)
+            {
+                for (size_t r = first; r < last; ++r)
+                {
+                    parseRecords(starts[r], starts[r + 1], firstRows[r], table);
+                } },
+            numThreads, 1);
+        return table;
+    }
+};
@@ -0,0 +1,679 @@
+#pragma once
+
+#include "include_file.h"
+#include "Metrics.h"
+#include "Parallel.h"
+#include "QuantileSketch.h"
+#include "Serialization.h"
+#include "Simd.h"
+
+// Per-column validity bitmaps: bit (i % 64) of words[j][i / 64] is set when
+// row i of column j is present. Built once per dataset with a SIMD NaN
+// compare per row; fit and transform use it to skip 64-row blocks that have
+// no missing values, and it doubles as a compact missing-indicator block
+// for downstream models (like sklearn's MissingIndicator).
+struct ValidityMask
+{
+    size_t num_rows = 0;
+    std::vector<std::vector<uint64_t>> words;
+    std::vector<size_t> missing_counts;
+
+    size_t numWords() const { return (num_rows + 63) / 64; }
+
+    // word with every row of block w present (the last block may be partial)
+    uint64_t fullWord(size_t w) const
+    {
+        const size_t rows = std::min<size_t>(64, num_rows - w * 64);
+        return rows == 64 ? ~uint64_t(0) : (uint64_t(1) << rows) - 1;
+    }
+
+    bool isMissing(size_t row, size_t column) const
+    {
+        return ((words[column][row / 64] >> (row % 64)) & 1) == 0;
+    }
+
+    // columns with at least one missing value
+    std::vector<size_t> missingColumns() const
+    {
+        std::vector<size_t> columns;
+        for (size_t j = 0; j < missing_counts.size(); ++j)
+        {
+            if (missing_counts[j] > 0)
+            {
+                columns.push_back(j);
+            }
+        }
+        return columns;
+    }
+
+    // dense 0/1 indicator features, rows x missingColumns()
+    std::vector<std::vector<uint8_t>> toDense() const
+    {
+        const std::vector<size_t> columns = missingColumns();
+        std::vector<std::vector<uint8_t>> indicator(num_rows, std::vector<uint8_t>(columns.size(), 0));
+        for (size_t k = 0; k < columns.size(); ++k)
+        {
+            for (size_t i = 0; i < num_rows; ++i)
+            {
+                indicator[i][k] = isMissing(i, columns[k]);
+            }
+        }
+        return indicator;
+    }
+
+    template <typename T>
+    static ValidityMask build(const std::vector<std::vector<T>> &rows)
+    {
+        ValidityMask mask;
+        mask.num_rows = rows.size();
+        const size_t num_columns = rows.empty() ? 0 : rows[0].size();
+
+        mask.words.assign(num_columns, std::vector<uint64_t>(mask.numWords()));
+        mask.missing_counts.assign(num_columns, 0);
+        for (size_t w = 0; w < mask.numWords(); ++w)
+        {
+            const uint64_t full = mask.fullWord(w);
+            for (auto &column : mask.words)
+            {
+                column[w] = full;
+            }
+        }
+
+        std::vector<uint64_t> row_nans((num_columns + 63) / 64);
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            if (!nan_bitmask(rows[i].data(), num_columns, row_nans.data()))
+            {
+                continue;
+            }
+            for (size_t w = 0; w < row_nans.size(); ++w)
+            {
+                for (uint64_t bits = row_nans[w]; bits != 0; bits &= bits - 1)
+                {
+                    const size_t j = w * 64 + __builtin_ctzll(bits);
+                    mask.words[j][i / 64] &= ~(uint64_t(1) << (i % 64));
+                    mask.missing_counts[j]++;
+                }
+            }
+        }
+        return mask;
+    }
+};
+
+// T is the storage type (float or double); means, medians and the streaming
+// sums are kept in double and narrowed to T only when written into a cell.
+// fit, partial_fit, fit_streaming and transform are recorded under
+// simple_imputer.* (Metrics.h).
+template <typename T = double>
+class SimpleImputer
+{
+private:
+    static_assert(std::is_floating_point_v<T>, "SimpleImputer marks missing values with NaN");
+
+    std::vector<std::vector<T>> data;
+    ValidityMask validity;
+    std::vector<double> column_means;
+    std::vector<double> column_medians;
+    std::vector<double> column_most_frequent;
+    double fill_value;
+
+    // streaming state: per-column running sums and median sketches (see partial_fit)
+    size_t sketch_k = 200;
+    std::vector<double> column_sums;
+    std::vector<size_t> column_counts;
+    std::vector<KllSketch<T>> column_sketches;
+    bool streaming = false;
+
+    void ensureStreamingColumns(size_t num_columns)
+    {
+        if (column_sketches.empty())
+        {
+            column_sums.assign(num_columns, 0.0);
+            column_counts.assign(num_columns, 0);
+            column_sketches.assign(num_columns, KllSketch<T>(sketch_k));
+        }
+        else if (column_sketches.size() != num_columns)
+        {
+            throw std::invalid_argument("Chunk has a different number of columns");
+        }
+    }
+
+    template <typename RowIterator>
+    void accumulateRows(RowIterator first, RowIterator last)
+    {
+        const size_t num_columns = first->size();
+        ensureStreamingColumns(num_columns);
+
+        for (; first != last; ++first)
+        {
+            const auto &row = *first;
+            for (size_t j = 0; j < num_columns; ++j)
+            {
+                if (!std::isnan(row[j]))
+                {
+                    column_sums[j] += row[j];
+                    column_counts[j]++;
+                    column_sketches[j].update(row[j]);
+                }
+            }
+        }
+    }
+
+    void refreshStreamingStatistics()
+    {
+        const size_t num_columns = column_sketches.size();
+        column_means.resize(num_columns);
+        column_medians.resize(num_columns);
+        column_most_frequent.assign(num_columns, std::numeric_limits<double>::quiet_NaN());
+
+        for (size_t j = 0; j < num_columns; ++j)
+        {
+            column_means[j] = column_sums[j] / column_counts[j];
+            column_medians[j] = column_sketches[j].empty() ? std::numeric_limits<double>::quiet_NaN()
+                                                           : column_sketches[j].quantile(0.5);
+        }
+        streaming = true;
+    }
+
+public:
+    SimpleImputer(std::vector<std::vector<T>> input_data, double fill = 0.0) : data(input_data), fill_value(fill) {}
+
+    // Imputer without in-memory data, fed through partial_fit / merge
+    explicit SimpleImputer(double fill = 0.0, size_t sketch_k_param = 200) : fill_value(fill), sketch_k(sketch_k_param) {}
+
+    void fit()
+    {
+        const size_t num_columns = data[0].size();
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("simple_imputer.fit");
+        const ScopedOperation timing(metrics, data.size(), data.size() * num_columns * sizeof(T));
+
+        validity = ValidityMask::build(data);
+        column_means.resize(num_columns);
+        column_medians.resize(num_columns);
+        column_most_frequent.resize(num_columns);
+
+        for (size_t j = 0; j < num_columns; ++j)
+        {
+            std::vector<T> column_values;
+            column_values.reserve(data.size() - validity.missing_counts[j]);
+
+            const std::vector<uint64_t> &words = validity.words[j];
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                const size_t base = w * 64;
+                if (words[w] == validity.fullWord(w))
+                {
+                    // fully valid block, no per-cell checks
+                    const size_t end = std::min(base + 64, data.size());
+                    for (size_t i = base; i < end; ++i)
+                    {
+                        column_values.push_back(data[i][j]);
+                    }
+                }
+                else
+                {
+                    for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1)
+                    {
+                        column_values.push_back(data[base + __builtin_ctzll(bits)][j]);
+                    }
+                }
+            }
+
+            column_means[j] = calculateMean(column_values);
+            column_most_frequent[j] = calculateMostFrequent(column_values);
+            column_medians[j] = calculateMedian(column_values); // reorders column_values, keep last
+        }
+        streaming = false;
+    }
+
+    // Single-pass, bounded-memory fit: accumulates running means and a KLL
+    // sketch per column, so the median is approximate (see KllSketch).
+    // most_frequent is not available in streaming mode.
+    void partial_fit(const std::vector<std::vector<T>> &chunk)
+    {
+        if (chunk.empty())
+        {
+            return;
+        }
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("simple_imputer.partial_fit");
+        const ScopedOperation timing(metrics, chunk.size(), chunk.size() * chunk[0].size() * sizeof(T));
+
+        accumulateRows(chunk.begin(), chunk.end());
+        refreshStreamingStatistics();
+    }
+
+    // Combines the streaming state of an imputer fitted on another shard
+    void merge(const SimpleImputer &other)
+    {
+        if (other.column_sketches.empty())
+        {
+            return;
+        }
+
+        ensureStreamingColumns(other.column_sketches.size());
+        for (size_t j = 0; j < column_sketches.size(); ++j)
+        {
+            column_sums[j] += other.column_sums[j];
+            column_counts[j] += other.column_counts[j];
+            column_sketches[j].merge(other.column_sketches[j]);
+        }
+        refreshStreamingStatistics();
+    }
+
+    // Streaming fit over the in-memory data: rows are sharded across threads,
+    // each shard builds its own sketches and the shards are merged at the end
+    void fit_streaming(size_t num_threads = 0)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("simple_imputer.fit_streaming");
+        const ScopedOperation timing(metrics, data.size(), data.empty() ? 0 : data.size() * data[0].size() * sizeof(T));
+        const size_t workers = parallel_workers(data.size(), num_threads);
+        std::vector<SimpleImputer> shards(workers, SimpleImputer(fill_value, sketch_k));
+
+        parallel_for(
+            data.size(),
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                if (begin < end)
+                {
+                    shards[worker].accumulateRows(data.begin() + begin, data.begin() + end);
+                }
+            },
+            num_threads);
+
+        column_sums.clear();
+        column_counts.clear();
+        column_sketches.clear();
+        for (const auto &shard : shards)
+        {
+            merge(shard);
+        }
+    }
+
+    std::vector<std::vector<T>> transform(std::string strategy)
+    {
+        if (validity.num_rows != data.size() || validity.words.empty())
+        {
+            validity = ValidityMask::build(data);
+        }
+        return fillMissing(data, validity, strategy);
+    }
+
+    std::vector<std::vector<T>> transform(const std::vector<std::vector<T>> &input, std::string strategy)
+    {
+        return fillMissing(input, ValidityMask::build(input), strategy);
+    }
+
+    // Missing-indicator block for the fitted data / for new input
+    const ValidityMask &missing_indicator()
+    {
+        if (validity.num_rows != data.size() || validity.words.empty())
+        {
+            validity = ValidityMask::build(data);
+        }
+        return validity;
+    }
+
+    ValidityMask missing_indicator(const std::vector<std::vector<T>> &input) const
+    {
+        return ValidityMask::build(input);
+    }
+
+    // Writes the fill values into the missing cells only, visiting just the
+    // 64-row blocks that contain a missing value
+    std::vector<std::vector<T>> fillMissing(const std::vector<std::vector<T>> &input, const ValidityMask &mask, const std::string &strategy) const
+    {
+        if (streaming && strategy == "most_frequent")
+        {
+            throw std::logic_error("most_frequent is not available after a streaming fit");
+        }
+
+        const size_t num_columns = mask.words.size();
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("simple_imputer.transform");
+        const ScopedOperation timing(metrics, input.size(), input.size() * num_columns * sizeof(T));
+
+        std::vector<std::vector<T>> transformed_data = input;
+
+        std::vector<double> constant;
+        const std::vector<double> *fill = nullptr;
+        if (strategy == "mean")
+        {
+            fill = &column_means;
+        }
+        else if (strategy == "median")
+        {
+            fill = &column_medians;
+        }
+        else if (strategy == "most_frequent")
+        {
+            fill = &column_most_frequent;
+        }
+        else if (strategy == "constant")
+        {
+            constant.assign(num_columns, fill_value);
+            fill = &constant;
+        }
+        else
+        {
+            return transformed_data;
+        }
+
+        for (size_t j = 0; j < num_columns; ++j)
+        {
+            if (mask.missing_counts[j] == 0)
+            {
+                continue;
+            }
+
+            const T value = static_cast<T>((*fill)[j]);
+            const std::vector<uint64_t> &words = mask.words[j];
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                for (uint64_t missing = mask.fullWord(w) & ~words[w]; missing != 0; missing &= missing - 1)
+                {
+                    transformed_data[w * 64 + __builtin_ctzll(missing)][j] = value;
+                }
+            }
+        }
+        return transformed_data;
+    }
+
+    double calculateMean(const std::vector<T> &values)
+    {
+        return std::accumulate(values.begin(), values.end(), 0.0) / values.size(); // double accumulator
+    }
+
+    double calculateMedian(std::vector<T> &values)
+    {
+        // selection instead of a full sort: nth_element places the upper middle
+        // element and partitions the smaller ones in front of it, O(n) on average
+        if (values.empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        const size_t middle = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + middle, values.end());
+        const double upper = static_cast<double>(values[middle]);
+
+        if (values.size() % 2 == 1)
+        {
+            return upper;
+        }
+        const double lower = static_cast<double>(*std::max_element(values.begin(), values.begin() + middle));
+        return (lower + upper) / 2;
+    }
+
+    double calculateMostFrequent(const std::vector<T> &values)
+    {
+        // hash histogram, ties go to the smallest value
+        if (values.empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        std::unordered_map<T, size_t> counts;
+        counts.reserve(values.size());
+        for (T value : values)
+        {
+            counts[value]++;
+        }
+
+        T most_frequent = values[0];
+        size_t max_count = 0;
+        for (const auto &[value, count] : counts)
+        {
+            if (count > max_count || (count == max_count && value < most_frequent))
+            {
+                max_count = count;
+                most_frequent = value;
+            }
+        }
+        return most_frequent;
+    }
+
+    // Saves the fitted statistics, not the data or the streaming sketches:
+    // a loaded imputer transforms new input, and partial_fit on it starts a
+    // new streaming fit
+    void save(BinaryWriter &writer) const
+    {
+        writer.writeHeader(SerialKind::SimpleImputer, serial_type<T>());
+        writer.write<double>(fill_value);
+        writer.write<uint8_t>(streaming);
+        writer.writeArray(column_means);
+        writer.writeArray(column_medians);
+        writer.writeArray(column_most_frequent);
+    }
+
+    static SimpleImputer load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::SimpleImputer, serial_type<T>());
+        SimpleImputer imputer(reader.read<double>());
+        imputer.streaming = reader.read<uint8_t>() != 0;
+        imputer.column_means = reader.readVector<double>();
+        imputer.column_medians = reader.readVector<double>();
+        imputer.column_most_frequent = reader.readVector<double>();
+        return imputer;
+    }
+};
+
+// KNN imputation: every missing value is replaced by the mean of that column
+// over the n_neighbors nearest complete rows seen in fit.
+// Distances are NaN-aware: only the coordinates present in the query row
+// count (the nan_euclidean rescaling is the same for every donor, so it does
+// not change the ranking and is skipped).
+// Distances are computed in tiles (a block of query rows against a block of
+// donor rows that fits in L2) with a bounded max-heap of the k best donors
+// per query, and query tiles are spread across threads.
+class KNNImputer
+{
+private:
+    size_t n_neighbors;
+    size_t num_columns = 0;
+    std::vector<double> donors; // complete rows, row-major
+    size_t num_donors = 0;
+    std::vector<double> column_means;
+
+    static constexpr size_t query_tile = 16;
+    static constexpr size_t donor_tile_bytes = 256 * 1024;
+
+    // k best (distance, donor) pairs, heap ordered with the worst on top
+    struct NeighborHeap
+    {
+        std::vector<std::pair<double, size_t>> entries;
+
+        void offer(double distance, size_t donor, size_t k)
+        {
+            if (entries.size() < k)
+            {
+                entries.emplace_back(distance, donor);
+                std::push_heap(entries.begin(), entries.end());
+            }
+            else if (distance < entries.front().first)
+            {
+                std::pop_heap(entries.begin(), entries.end());
+                entries.back() = {distance, donor};
+                std::push_heap(entries.begin(), entries.end());
+            }
+        }
+    };
+
+public:
+    explicit KNNImputer(size_t k = 5) : n_neighbors(k)
+    {
+        if (n_neighbors < 1)
+        {
+            throw std::invalid_argument("Number of neighbors must be at least 1");
+        }
+    }
+
+    void fit(const std::vector<std::vector<double>> &input_data)
+    {
+        if (input_data.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+
+        for (const auto &row : input_data)
+        {
+            if (row.size() != input_data[0].size())
+            {
+                throw std::invalid_argument("Inconsistent number of features in input data");
+            }
+        }
+
+        num_columns = input_data[0].size();
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("knn_imputer.fit");
+        const ScopedOperation timing(metrics, input_data.size(), input_data.size() * num_columns * sizeof(double));
+        donors.clear();
+        num_donors = 0;
+
+        std::vector<double> sums(num_columns, 0.0);
+        std::vector<size_t> counts(num_columns, 0);
+
+        for (const auto &row : input_data)
+        {
+            bool complete = true;
+            for (size_t j = 0; j < num_columns; ++j)
+            {
+                if (std::isnan(row[j]))
+                {
+                    complete = false;
+                }
+                else
+                {
+                    sums[j] += row[j];
+                    counts[j]++;
+                }
+            }
+            if (complete)
+            {
+                donors.insert(donors.end(), row.begin(), row.end());
+                ++num_donors;
+            }
+        }
+
+        // fallback when there are no complete rows; a column with no observed
+        // value at all is filled with 0 (as sklearn's keep_empty_features)
+        column_means.resize(num_columns);
+        for (size_t j = 0; j < num_columns; ++j)
+        {
+            column_means[j] = counts[j] > 0 ? sums[j] / counts[j] : 0.0;
+        }
+    }
+
+    std::vector<std::vector<double>> transform(const std::vector<std::vector<double>> &input_data, size_t num_threads = 0) const
+    {
+        if (column_means.empty())
+        {
+            throw std::logic_error("KNNImputer has not been fitted. Call fit method first.");
+        }
+        for (const auto &row : input_data)
+        {
+            if (row.size() != num_columns)
+            {
+                throw std::invalid_argument("Number of features does not match the fitted data");
+            }
+        }
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("knn_imputer.transform");
+        const ScopedOperation timing(metrics, input_data.size(), input_data.size() * num_columns * sizeof(double));
+        std::vector<std::vector<double>> transformed_data = input_data;
+
+        // only rows with at least one missing value are queries
+        std::vector<size_t> query_rows;
+        for (size_t i = 0; i < input_data.size(); ++i)
+        {
+            if (std::any_of(input_data[i].begin(), input_data[i].end(), [](double v)
+                            { return std::isnan(v); }))
+            {
+                query_rows.push_back(i);
+            }
+        }
+
+        if (query_rows.empty())
+        {
+            return transformed_data;
+        }
+
+        if (num_donors == 0)
+        {
+            for (size_t i : query_rows)
+            {
+                for (size_t j = 0; j < num_columns; ++j)
+                {
+                    if (std::isnan(transformed_data[i][j]))
+                    {
+                        transformed_data[i][j] = column_means[j];
+                    }
+                }
+            }
+            return transformed_data;
+        }
+
+        const size_t k = std::min(n_neighbors, num_donors);
+        const size_t donor_tile = std::max<size_t>(1, donor_tile_bytes / (num_columns * sizeof(double)));
+        const size_t num_query_tiles = (query_rows.size() + query_tile - 1) / query_tile;
+
+        parallel_for(
+            num_query_tiles,
+            [&](size_t tile_begin, size_t tile_end, size_t)
+            {
+                // zero-filled query values and 0/1 presence masks for one tile
+                std::vector<double> queries(query_tile * num_columns);
+                std::vector<double> masks(query_tile * num_columns);
+                std::vector<NeighborHeap> heaps(query_tile);
+
+                for (size_t tile = tile_begin; tile < tile_end; ++tile)
+                {
+                    const size_t first = tile * query_tile;
+                    const size_t count = std::min(query_tile, query_rows.size() - first);
+
+                    for (size_t q = 0; q < count; ++q)
+                    {
+                        const auto &row = input_data[query_rows[first + q]];
+                        for (size_t j = 0; j < num_columns; ++j)
+                        {
+                            const bool present = !std::isnan(row[j]);
+                            queries[q * num_columns + j] = present ? row[j] : 0.0;
+                            masks[q * num_columns + j] = present ? 1.0 : 0.0;
+                        }
+                        heaps[q].entries.clear();
+                    }
+
+                    for (size_t d0 = 0; d0 < num_donors; d0 += donor_tile)
+                    {
+                        const size_t d1 = std::min(num_donors, d0 + donor_tile);
+                        for (size_t q = 0; q < count; ++q)
+                        {
+                            const double *query = &queries[q * num_columns];
+                            const double *mask = &masks[q * num_columns];
+                            for (size_t d = d0; d < d1; ++d)
+                            {
+                                const double distance = masked_squared_distance(query, mask, &donors[d * num_columns], num_columns);
+                                heaps[q].offer(distance, d, k);
+                            }
+                        }
+                    }
+
+                    for (size_t q = 0; q < count; ++q)
+                    {
+                        auto &row = transformed_data[query_rows[first + q]];
+                        for (size_t j = 0; j < num_columns; ++j)
+                        {
+                            if (std::isnan(row[j]))
+                            {
+                                double sum = 0.0;
+                                for (const auto &neighbor : heaps[q].entries)
+                                {
+                                    sum += donors[neighbor.second * num_columns + j];
+                                }
+                                row[j] = sum / heaps[q].entries.size();
+                            }
+                        }
+                    }
+                }
+            },
+            num_threads, 1);
+
+        return transformed_data;
+    }
+};
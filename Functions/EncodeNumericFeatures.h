@@ -0,0 +1,1041 @@
+#pragma once
+
+// converting numeric features to categorical features -- binning (discretization) & binarization
+
+/*
+Binning --
+    supervised binning --
+        1. equal width binning ( width = (max-min)/n ) (uniform binning) ( n = bins )
+        2. equal frequency binning ( quantile binning)
+        3. k-means binning
+    unsupervised binning --
+        1. clustering based binning
+        2. decision tree based binning
+        3. quantile based binning
+    custom binning --
+        1. binning based on domain knowledge
+        2. binning based on business rules
+        3. binning based on data distribution
+*/
+
+#include "include_file.h"
+#include "BinCut.h"
+#include "Metrics.h"
+#include "Parallel.h"
+#include "QuantileSketch.h"
+#include "Serialization.h"
+
+// Equal-width binning: width = (max - min) / numBins.
+// One pass for min / max, then one pass that computes every bin index
+// arithmetically and counts into dense per-thread histograms that are merged
+// at the end, so there is no sort and no hashing. If all values are equal the
+// range is widened by 0.1% on each side, like pd.cut. The range comes from the
+// finite values only; NaN is not counted, and +-inf counts in the end bins
+// (where cut puts it).
+template <typename T>
+class UniformBinning
+{
+private:
+    size_t numBins;
+    std::vector<T> binEdges;
+    std::vector<size_t> binCounts;
+    BinCutter<T> cutter;
+
+    UniformBinning() : numBins(0) {}
+
+public:
+    /// @brief
+    /// @param input_data
+    /// @param num_bins
+    /// @param num_threads 0 = one per hardware thread
+    UniformBinning(const std::vector<T> &input_data, size_t num_bins, size_t num_threads = 0) : numBins(num_bins)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("uniform_binning.fit");
+        const ScopedOperation timing(metrics, input_data.size(), input_data.size() * sizeof(T));
+        if (input_data.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        if (numBins < 1)
+        {
+            throw std::invalid_argument("Number of bins must be at least 1");
+        }
+
+        const T *data = input_data.data();
+        const size_t dataSize = input_data.size();
+
+        // Pass 1: min / max of the finite values
+        const size_t workers = parallel_workers(dataSize, num_threads);
+        std::vector<std::pair<T, T>> ranges(workers, {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()});
+        parallel_for(
+            dataSize,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                T low = ranges[worker].first;
+                T high = ranges[worker].second;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const bool finite = std::isfinite(data[i]);
+                    low = finite && data[i] < low ? data[i] : low;
+                    high = finite && data[i] > high ? data[i] : high;
+                }
+                ranges[worker] = {low, high};
+            },
+            num_threads);
+
+        double low = static_cast<double>(ranges[0].first);
+        double high = static_cast<double>(ranges[0].second);
+        for (const auto &range : ranges)
+        {
+            low = std::min(low, static_cast<double>(range.first));
+            high = std::max(high, static_cast<double>(range.second));
+        }
+        if (low > high)
+        {
+            throw std::invalid_argument("Input data has no finite values");
+        }
+        if (low == high)
+        {
+            const double pad = low == 0.0 ? 0.001 : 0.001 * std::abs(low);
+            low -= pad;
+            high += pad;
+        }
+
+        // Compute bin edges
+        const double width = (high - low) / numBins;
+        binEdges.resize(numBins + 1);
+        for (size_t i = 0; i < numBins; ++i)
+        {
+            binEdges[i] = static_cast<T>(low + i * width);
+        }
+        binEdges[numBins] = static_cast<T>(high);
+
+        cutter = BinCutter<T>(binEdges);
+
+        // Pass 2: count data points in each bin, one dense histogram per thread
+        std::vector<std::vector<size_t>> histograms(workers, std::vector<size_t>(numBins, 0));
+        parallel_for(
+            dataSize,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                std::vector<size_t> &histogram = histograms[worker];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    histogram[cutter(data[i])] += !std::isnan(data[i]);
+                }
+            },
+            num_threads);
+
+        binCounts.assign(numBins, 0);
+        for (const auto &histogram : histograms)
+        {
+            for (size_t b = 0; b < numBins; ++b)
+            {
+                binCounts[b] += histogram[b];
+            }
+        }
+    }
+
+    // Batch cut into a caller buffer, e.g. uint8_t / uint16_t bin codes (see BinCutter)
+    template <typename Code>
+    void cut(const T *input, size_t n, Code *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("uniform_binning.cut");
+        const ScopedOperation timing(metrics, n, n * sizeof(T));
+        cutter.cut(input, n, codes);
+    }
+
+    // Cut function similar to pd.cut
+    std::vector<size_t> cut(const std::vector<T> &input) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("uniform_binning.cut");
+        const ScopedOperation timing(metrics, input.size(), input.size() * sizeof(T));
+        return cutter.cut(input);
+    }
+
+    size_t getBinCount(size_t binIndex) const
+    {
+        if (binIndex >= numBins)
+        {
+            throw std::out_of_range("Bin index out of range");
+        }
+        return binCounts[binIndex];
+    }
+
+    const std::vector<T> &getBinEdges() const
+    {
+        return binEdges;
+    }
+
+    void save(BinaryWriter &writer) const
+    {
+        writer.writeHeader(SerialKind::UniformBinning, serial_type<T>());
+        writer.writeArray(binEdges);
+        writer.writeArray(std::vector<uint64_t>(binCounts.begin(), binCounts.end()));
+    }
+
+    static UniformBinning load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::UniformBinning, serial_type<T>());
+        UniformBinning binning;
+        binning.binEdges = reader.readVector<T>();
+        const std::vector<uint64_t> counts = reader.readVector<uint64_t>();
+        if (binning.binEdges.size() < 2 || counts.size() != binning.binEdges.size() - 1)
+        {
+            throw std::runtime_error("Corrupt UniformBinning");
+        }
+        binning.numBins = counts.size();
+        binning.binCounts.assign(counts.begin(), counts.end());
+        binning.cutter = BinCutter<T>(binning.binEdges);
+        return binning;
+    }
+};
+
+// Quantile Binning
+template <typename T>
+class QuantileBinning
+{
+private:
+    std::vector<T> data;
+    size_t numBins;
+    std::vector<T> binEdges;
+    std::unordered_map<size_t, size_t> binCounts;
+    BinCutter<T> cutter;
+
+    QuantileBinning() : numBins(0) {}
+
+public:
+    QuantileBinning(const std::vector<T> &input_data, size_t num_bins)
+        : data(input_data), numBins(num_bins)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("quantile_binning.fit");
+        const ScopedOperation timing(metrics, input_data.size(), input_data.size() * sizeof(T));
+        if (data.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        if (numBins < 1)
+        {
+            throw std::invalid_argument("Number of bins must be at least 1");
+        }
+
+        // Sort the data
+        std::sort(data.begin(), data.end());
+
+        // Compute bin edges
+        size_t dataSize = data.size();
+        size_t binSize = dataSize / numBins;
+        size_t remainder = dataSize % numBins;
+
+        binEdges.resize(numBins + 1);
+
+        size_t dataIndex = 0;
+        for (size_t i = 0; i < numBins; ++i)
+        {
+            size_t binEnd = dataIndex + binSize + (i < remainder ? 1 : 0);
+            binEdges[i] = data[std::min(binEnd, dataSize) - 1];
+            dataIndex = std::min(binEnd, dataSize);
+        }
+        binEdges[numBins] = data.back(); // Last edge
+
+        // Count data points in each bin
+        binCounts.reserve(numBins);
+        size_t binIndex = 0;
+        for (size_t i = 0; i < dataSize; ++i)
+        {
+            if (data[i] > binEdges[binIndex + 1])
+            {
+                ++binIndex;
+                if (binIndex >= numBins)
+                    break;
+            }
+            binCounts[binIndex]++;
+        }
+
+        cutter = BinCutter<T>(binEdges);
+    }
+
+    // Batch cut into a caller buffer, e.g. uint8_t / uint16_t bin codes (see BinCutter)
+    template <typename Code>
+    void cut(const T *input, size_t n, Code *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("quantile_binning.cut");
+        const ScopedOperation timing(metrics, n, n * sizeof(T));
+        cutter.cut(input, n, codes);
+    }
+
+    // Cut function similar to pd.cut
+    std::vector<size_t> cut(const std::vector<T> &input) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("quantile_binning.cut");
+        const ScopedOperation timing(metrics, input.size(), input.size() * sizeof(T));
+        return cutter.cut(input);
+    }
+
+    size_t getBinCount(size_t binIndex) const
+    {
+        if (binIndex >= numBins)
+        {
+            throw std::out_of_range("Bin index out of range");
+        }
+        return binCounts.at(binIndex);
+    }
+
+    const std::vector<T> &getBinEdges() const
+    {
+        return binEdges;
+    }
+
+    // Edges and counts only, the sorted copy of the training data is not kept
+    void save(BinaryWriter &writer) const
+    {
+        writer.writeHeader(SerialKind::QuantileBinning, serial_type<T>());
+        writer.writeArray(binEdges);
+        std::vector<uint64_t> bins;
+        std::vector<uint64_t> counts;
+        for (const auto &[bin, count] : binCounts)
+        {
+            bins.push_back(bin);
+            counts.push_back(count);
+        }
+        writer.writeArray(bins);
+        writer.writeArray(counts);
+    }
+
+    static QuantileBinning load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::QuantileBinning, serial_type<T>());
+        QuantileBinning binning;
+        binning.binEdges = reader.readVector<T>();
+        const std::vector<uint64_t> bins = reader.readVector<uint64_t>();
+        const std::vector<uint64_t> counts = reader.readVector<uint64_t>();
+        if (binning.binEdges.size() < 2 || bins.size() != counts.size())
+        {
+            throw std::runtime_error("Corrupt QuantileBinning");
+        }
+        binning.numBins = binning.binEdges.size() - 1;
+        for (size_t i = 0; i < bins.size(); ++i)
+        {
+            binning.binCounts[bins[i]] = counts[i];
+        }
+        binning.cutter = BinCutter<T>(binning.binEdges);
+        return binning;
+    }
+};
+
+// Streaming Quantile Binning
+// Same bins as QuantileBinning (edges at the i/numBins quantiles, first and
+// last edge at min / max) but backed by a KLL sketch: data is ingested in
+// chunks, sketches built by parallel workers or from other files are merged,
+// and the full column is never held in memory. Edge ranks are within
+// getRankError() of the exact ones. Edges are rebuilt at the end of every
+// update / merge (one sort of the ~k log n retained items), so the const
+// methods only read and a fitted binner can be cut from several threads.
+template <typename T>
+class StreamingQuantileBinning
+{
+private:
+    size_t numBins;
+    KllSketch<T> sketch;
+    std::vector<T> binEdges;
+    BinCutter<T> cutter;
+
+    void rebuildEdges()
+    {
+        if (sketch.empty())
+        {
+            return;
+        }
+        sketch.prepareQueries(); // getBinCount's rank queries then only read
+        binEdges.resize(numBins + 1);
+        for (size_t i = 0; i <= numBins; ++i)
+        {
+            binEdges[i] = sketch.quantile(static_cast<double>(i) / numBins);
+        }
+        cutter = BinCutter<T>(binEdges);
+    }
+
+public:
+    StreamingQuantileBinning(size_t num_bins, size_t sketch_k = 200)
+        : numBins(num_bins), sketch(sketch_k)
+    {
+        if (numBins < 1)
+        {
+            throw std::invalid_argument("Number of bins must be at least 1");
+        }
+    }
+
+    void update(const T *values, size_t count)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("streaming_quantile_binning.update");
+        const ScopedOperation timing(metrics, count, count * sizeof(T));
+        sketch.update(values, count);
+        rebuildEdges();
+    }
+
+    void update(const std::vector<T> &chunk)
+    {
+        update(chunk.data(), chunk.size());
+    }
+
+    // Sketches one chunk per thread and merges the per-thread sketches
+    void update(const T *values, size_t count, size_t num_threads)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("streaming_quantile_binning.update");
+        const ScopedOperation timing(metrics, count, count * sizeof(T));
+        const size_t workers = parallel_workers(count, num_threads, 1 << 16);
+        std::vector<KllSketch<T>> partial(workers, KllSketch<T>(sketch.getK()));
+        parallel_for(
+            count,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                partial[worker].update(values + begin, end - begin);
+            },
+            num_threads, 1 << 16);
+
+        for (const auto &part : partial)
+        {
+            sketch.merge(part);
+        }
+        rebuildEdges();
+    }
+
+    void merge(const StreamingQuantileBinning &other)
+    {
+        sketch.merge(other.sketch);
+        rebuildEdges();
+    }
+
+    const std::vector<T> &getBinEdges() const
+    {
+        if (sketch.empty())
+        {
+            throw std::logic_error("No data has been added");
+        }
+        return binEdges;
+    }
+
+    // Estimated number of values in the bin, from the sketch ranks of its edges
+    size_t getBinCount(size_t binIndex) const
+    {
+        if (binIndex >= numBins)
+        {
+            throw std::out_of_range("Bin index out of range");
+        }
+
+        const std::vector<T> &edges = getBinEdges();
+        const double upper = sketch.rank(edges[binIndex + 1]);
+        const double lower = binIndex == 0 ? 0.0 : sketch.rank(edges[binIndex]);
+        return static_cast<size_t>(std::llround(std::max(0.0, upper - lower) * sketch.count()));
+    }
+
+    template <typename Code>
+    void cut(const T *input, size_t n, Code *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("streaming_quantile_binning.cut");
+        const ScopedOperation timing(metrics, n, n * sizeof(T));
+        getBinEdges();
+        cutter.cut(input, n, codes);
+    }
+
+    std::vector<size_t> cut(const std::vector<T> &input) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("streaming_quantile_binning.cut");
+        const ScopedOperation timing(metrics, input.size(), input.size() * sizeof(T));
+        getBinEdges();
+        return cutter.cut(input);
+    }
+
+    double getRankError() const
+    {
+        return sketch.normalizedRankError();
+    }
+
+    uint64_t size() const
+    {
+        return sketch.count();
+    }
+};
+
+// K-Means Binning
+// 1-D k-means is solved exactly (Ckmeans.1d.dp, Wang & Song 2011): on sorted
+// data every cluster is a contiguous run, so the optimal partition comes from
+// a dynamic program over prefix sums. Each DP row is filled with the
+// divide-and-conquer optimisation (the optimal split point is monotone),
+// O(k * m log m) for m distinct values, and the result is deterministic.
+// Duplicate values are collapsed into weighted points first.
+//
+// For very large inputs the DP can run on a strided sample (sample_size) and
+// the centroids then be refined on the full data with parallel Lloyd
+// iterations (refine_iterations). If there are fewer distinct values than
+// bins, numBins is reduced to the number of distinct values.
+template <typename T>
+class KMeansBinning
+{
+private:
+    size_t numBins;
+    std::vector<T> binEdges;
+    std::vector<T> centroids;
+    BinCutter<T> cutter;
+    double inertia = 0.0;
+
+    KMeansBinning() : numBins(0) {}
+
+    // Weighted sorted distinct values with prefix sums of w, w*x and w*x^2
+    // (x shifted by the median to limit cancellation)
+    struct PrefixSums
+    {
+        std::vector<double> values;
+        std::vector<double> weight;
+        std::vector<double> sum;
+        std::vector<double> sumSquares;
+        double shift = 0.0;
+
+        // within-cluster sum of squares of distinct values [first, last]
+        double cost(size_t first, size_t last) const
+        {
+            const double w = weight[last + 1] - weight[first];
+            const double s = sum[last + 1] - sum[first];
+            const double q = sumSquares[last + 1] - sumSquares[first];
+            return std::max(0.0, q - s * s / w);
+        }
+
+        double mean(size_t first, size_t last) const
+        {
+            const double w = weight[last + 1] - weight[first];
+            return (sum[last + 1] - sum[first]) / w + shift;
+        }
+    };
+
+    static PrefixSums buildPrefixSums(std::vector<T> sorted)
+    {
+        std::sort(sorted.begin(), sorted.end());
+
+        PrefixSums prefix;
+        prefix.shift = static_cast<double>(sorted[sorted.size() / 2]);
+        prefix.weight.push_back(0.0);
+        prefix.sum.push_back(0.0);
+        prefix.sumSquares.push_back(0.0);
+
+        for (size_t i = 0; i < sorted.size();)
+        {
+            size_t run = i + 1;
+            while (run < sorted.size() && sorted[run] == sorted[i])
+            {
+                ++run;
+            }
+            const double w = static_cast<double>(run - i);
+            const double x = static_cast<double>(sorted[i]) - prefix.shift;
+            prefix.values.push_back(static_cast<double>(sorted[i]));
+            prefix.weight.push_back(prefix.weight.back() + w);
+            prefix.sum.push_back(prefix.sum.back() + w * x);
+            prefix.sumSquares.push_back(prefix.sumSquares.back() + w * x * x);
+            i = run;
+        }
+        return prefix;
+    }
+
+    // Fills current[i] = min_j previous[j - 1] + cost(j, i) for i in [iLow, iHigh],
+    // searching j in [jLow, jHigh]; the optimal j is monotone in i
+    static void fillRow(const PrefixSums &prefix, const std::vector<double> &previous, std::vector<double> &current,
+                        std::vector<uint32_t> &split, size_t cluster, size_t iLow, size_t iHigh, size_t jLow, size_t jHigh)
+    {
+        if (iLow > iHigh)
+        {
+            return;
+        }
+
+        const size_t i = iLow + (iHigh - iLow) / 2;
+        const size_t jFirst = std::max(jLow, cluster);
+        const size_t jLast = std::min(jHigh, i);
+
+        double best = std::numeric_limits<double>::infinity();
+        size_t bestJ = jFirst;
+        for (size_t j = jFirst; j <= jLast; ++j)
+        {
+            const double candidate = previous[j - 1] + prefix.cost(j, i);
+            if (candidate < best)
+            {
+                best = candidate;
+                bestJ = j;
+            }
+        }
+        current[i] = best;
+        split[i] = static_cast<uint32_t>(bestJ);
+
+        if (i > iLow)
+        {
+            fillRow(prefix, previous, current, split, cluster, iLow, i - 1, jLow, bestJ);
+        }
+        fillRow(prefix, previous, current, split, cluster, i + 1, iHigh, bestJ, jHigh);
+    }
+
+    // Exact optimal centroids for the given values
+    void fitOptimal(const std::vector<T> &values)
+    {
+        const PrefixSums prefix = buildPrefixSums(values);
+        const size_t m = prefix.values.size();
+        numBins = std::min(numBins, m);
+
+        // splits[c][i]: first distinct value of cluster c when clusters 0..c cover [0, i]
+        std::vector<std::vector<uint32_t>> splits(numBins, std::vector<uint32_t>(m, 0));
+        std::vector<double> previous(m), current(m);
+        for (size_t i = 0; i < m; ++i)
+        {
+            previous[i] = prefix.cost(0, i);
+        }
+
+        for (size_t c = 1; c < numBins; ++c)
+        {
+            std::fill(current.begin(), current.end(), std::numeric_limits<double>::infinity());
+            fillRow(prefix, previous, current, splits[c], c, c, m - 1, c, m - 1);
+            std::swap(previous, current);
+        }
+        inertia = previous[m - 1];
+
+        centroids.assign(numBins, T());
+        size_t last = m - 1;
+        for (size_t c = numBins; c-- > 0;)
+        {
+            const size_t first = c == 0 ? 0 : splits[c][last];
+            centroids[c] = static_cast<T>(prefix.mean(first, last));
+            if (first > 0)
+            {
+                last = first - 1;
+            }
+        }
+    }
+
+    // Lloyd iterations on the full data: assignment by binary search over the
+    // centroid midpoints, per-thread sums merged after each pass
+    void refine(const std::vector<T> &data, size_t maxIterations, size_t numThreads)
+    {
+        for (size_t iter = 0; iter < maxIterations; ++iter)
+        {
+            std::vector<double> midpoints(numBins - 1);
+            for (size_t c = 0; c + 1 < numBins; ++c)
+            {
+                midpoints[c] = (static_cast<double>(centroids[c]) + static_cast<double>(centroids[c + 1])) / 2;
+            }
+
+            const size_t workers = parallel_workers(data.size(), numThreads);
+            std::vector<std::vector<double>> sums(workers, std::vector<double>(numBins, 0.0));
+            std::vector<std::vector<double>> squares(workers, std::vector<double>(numBins, 0.0));
+            std::vector<std::vector<size_t>> counts(workers, std::vector<size_t>(numBins, 0));
+
+            parallel_for(
+                data.size(),
+                [&](size_t begin, size_t end, size_t worker)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const double x = static_cast<double>(data[i]);
+                        const size_t c = std::upper_bound(midpoints.begin(), midpoints.end(), x) - midpoints.begin();
+                        sums[worker][c] += x;
+                        squares[worker][c] += x * x;
+                        counts[worker][c]++;
+                    }
+                },
+                numThreads);
+
+            std::vector<T> updated = centroids;
+            inertia = 0.0;
+            for (size_t c = 0; c < numBins; ++c)
+            {
+                double sum = 0.0, sumSquares = 0.0;
+                size_t count = 0;
+                for (size_t w = 0; w < workers; ++w)
+                {
+                    sum += sums[w][c];
+                    sumSquares += squares[w][c];
+                    count += counts[w][c];
+                }
+                if (count > 0)
+                {
+                    updated[c] = static_cast<T>(sum / count);
+                    inertia += std::max(0.0, sumSquares - sum * sum / count);
+                }
+            }
+            std::sort(updated.begin(), updated.end());
+
+            const bool converged = updated == centroids;
+            centroids = std::move(updated);
+            if (converged)
+            {
+                break;
+            }
+        }
+    }
+
+public:
+    KMeansBinning(const std::vector<T> &input_data, size_t num_bins, size_t refine_iterations = 0,
+                  size_t sample_size = 0, size_t num_threads = 0)
+        : numBins(num_bins)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("kmeans_binning.fit");
+        const ScopedOperation timing(metrics, input_data.size(), input_data.size() * sizeof(T));
+        if (input_data.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        if (numBins < 1)
+        {
+            throw std::invalid_argument("Number of bins must be at least 1");
+        }
+
+        if (sample_size > 0 && sample_size < input_data.size())
+        {
+            // deterministic strided sample
+            std::vector<T> sample;
+            sample.reserve(sample_size);
+            const double stride = static_cast<double>(input_data.size()) / sample_size;
+            for (size_t i = 0; i < sample_size; ++i)
+            {
+                sample.push_back(input_data[static_cast<size_t>(i * stride)]);
+            }
+            fitOptimal(sample);
+        }
+        else
+        {
+            fitOptimal(input_data);
+        }
+
+        if (refine_iterations > 0)
+        {
+            refine(input_data, refine_iterations, num_threads);
+        }
+
+        computeBinEdges();
+    }
+
+    // Batch cut into a caller buffer, e.g. uint8_t / uint16_t bin codes (see BinCutter)
+    template <typename Code>
+    void cut(const T *input, size_t n, Code *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("kmeans_binning.cut");
+        const ScopedOperation timing(metrics, n, n * sizeof(T));
+        cutter.cut(input, n, codes);
+    }
+
+    // Cut function similar to pd.cut
+    std::vector<size_t> cut(const std::vector<T> &input) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("kmeans_binning.cut");
+        const ScopedOperation timing(metrics, input.size(), input.size() * sizeof(T));
+        return cutter.cut(input);
+    }
+
+    // Compute bin edges based on centroids: midpoints between neighbouring
+    // centroids, open-ended first and last edge
+    void computeBinEdges()
+    {
+        binEdges.clear();
+        binEdges.resize(numBins + 1);
+        binEdges[0] = std::numeric_limits<T>::lowest();
+        for (size_t i = 1; i < numBins; ++i)
+        {
+            binEdges[i] = (centroids[i - 1] + centroids[i]) / 2;
+        }
+        binEdges[numBins] = std::numeric_limits<T>::max(); // Last edge
+        cutter = BinCutter<T>(binEdges);
+    }
+
+    const std::vector<T> &getBinEdges() const
+    {
+        return binEdges;
+    }
+
+    const std::vector<T> &getCentroids() const
+    {
+        return centroids;
+    }
+
+    // Within-cluster sum of squares
+    double getInertia() const
+    {
+        return inertia;
+    }
+
+    size_t getNumBins() const
+    {
+        return numBins;
+    }
+
+    // The edges are recomputed from the centroids on load
+    void save(BinaryWriter &writer) const
+    {
+        writer.writeHeader(SerialKind::KMeansBinning, serial_type<T>());
+        writer.write<double>(inertia);
+        writer.writeArray(centroids);
+    }
+
+    static KMeansBinning load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::KMeansBinning, serial_type<T>());
+        KMeansBinning binning;
+        binning.inertia = reader.read<double>();
+        binning.centroids = reader.readVector<T>();
+        if (binning.centroids.empty())
+        {
+            throw std::runtime_error("Corrupt KMeansBinning");
+        }
+        binning.numBins = binning.centroids.size();
+        binning.computeBinEdges();
+        return binning;
+    }
+};
+
+// Decision Tree Binning (supervised)
+// Split points come from a regression tree on the target, grown on
+// pre-quantised histograms like LightGBM:
+//   1. the column is pre-quantised into at most numPreBins bins at KLL
+//      sketch quantiles (one pass)
+//   2. one pass builds a per-bin histogram of target sums and counts
+//   3. the tree is grown best-first over histogram ranges (a split is a
+//      pre-bin boundary, gain = variance reduction), until maxBins leaves,
+//      no positive gain, or minSamplesLeaf would be violated
+// Split search never touches the raw values again, so the cost is linear in
+// the number of rows. For a 0/1 target the gain is the Gini gain.
+template <typename T>
+class DecisionTreeBinning
+{
+private:
+    size_t maxBins;
+    size_t minSamplesLeaf;
+    std::vector<T> binEdges;
+    std::vector<size_t> binCounts;
+    BinCutter<T> cutter;
+
+    // candidate leaf: pre-bins [first, last) and its best split
+    struct Leaf
+    {
+        size_t first, last;
+        size_t split;
+        double gain;
+
+        bool operator<(const Leaf &other) const
+        {
+            return gain < other.gain;
+        }
+    };
+
+    static Leaf bestSplit(size_t first, size_t last, const std::vector<double> &sums, const std::vector<size_t> &counts, size_t minLeaf)
+    {
+        Leaf leaf{first, last, first, 0.0};
+        double totalSum = 0.0;
+        size_t totalCount = 0;
+        for (size_t b = first; b < last; ++b)
+        {
+            totalSum += sums[b];
+            totalCount += counts[b];
+        }
+        if (totalCount == 0)
+        {
+            return leaf;
+        }
+        const double parent = totalSum * totalSum / totalCount;
+
+        double leftSum = 0.0;
+        size_t leftCount = 0;
+        for (size_t b = first; b + 1 < last; ++b)
+        {
+            leftSum += sums[b];
+            leftCount += counts[b];
+            const size_t rightCount = totalCount - leftCount;
+            if (leftCount < minLeaf || rightCount < minLeaf)
+            {
+                continue;
+            }
+            const double rightSum = totalSum - leftSum;
+            const double gain = leftSum * leftSum / leftCount + rightSum * rightSum / rightCount - parent;
+            if (gain > leaf.gain)
+            {
+                leaf.gain = gain;
+                leaf.split = b + 1;
+            }
+        }
+        return leaf;
+    }
+
+public:
+    /// @param target one value per row (regression target or 0/1 label)
+    /// @param max_bins maximum number of bins (tree leaves)
+    /// @param num_pre_bins histogram resolution, split candidates per column
+    DecisionTreeBinning(const std::vector<T> &input_data, const std::vector<double> &target, size_t max_bins,
+                        size_t min_samples_leaf = 1, size_t num_pre_bins = 255, size_t num_threads = 0)
+        : maxBins(max_bins), minSamplesLeaf(std::max<size_t>(1, min_samples_leaf))
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("decision_tree_binning.fit");
+        const ScopedOperation timing(metrics, input_data.size(), input_data.size() * sizeof(T));
+        if (input_data.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        if (input_data.size() != target.size())
+        {
+            throw std::invalid_argument("Input data and target have different sizes");
+        }
+        if (maxBins < 1 || num_pre_bins < 1)
+        {
+            throw std::invalid_argument("Number of bins must be at least 1");
+        }
+
+        // 1. pre-quantisation edges
+        KllSketch<T> sketch;
+        sketch.update(input_data);
+        if (sketch.empty())
+        {
+            throw std::invalid_argument("Input data has no valid values");
+        }
+        std::vector<T> preEdges;
+        for (size_t i = 0; i <= num_pre_bins; ++i)
+        {
+            const T edge = sketch.quantile(static_cast<double>(i) / num_pre_bins);
+            if (preEdges.empty() || edge > preEdges.back())
+            {
+                preEdges.push_back(edge);
+            }
+        }
+        if (preEdges.size() == 1)
+        {
+            preEdges.push_back(preEdges.back());
+        }
+        const BinCutter<T> preCutter(preEdges);
+        const size_t numPreBins = preEdges.size() - 1;
+
+        // 2. target sum / count histogram, one per thread
+        const size_t workers = parallel_workers(input_data.size(), num_threads);
+        std::vector<std::vector<double>> partialSums(workers, std::vector<double>(numPreBins, 0.0));
+        std::vector<std::vector<size_t>> partialCounts(workers, std::vector<size_t>(numPreBins, 0));
+        parallel_for(
+            input_data.size(),
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if constexpr (std::is_floating_point_v<T>)
+                    {
+                        if (std::isnan(input_data[i]))
+                        {
+                            continue;
+                        }
+                    }
+                    const size_t bin = preCutter(input_data[i]);
+                    partialSums[worker][bin] += target[i];
+                    partialCounts[worker][bin]++;
+                }
+            },
+            num_threads);
+
+        std::vector<double> sums(numPreBins, 0.0);
+        std::vector<size_t> counts(numPreBins, 0);
+        for (size_t w = 0; w < workers; ++w)
+        {
+            for (size_t b = 0; b < numPreBins; ++b)
+            {
+                sums[b] += partialSums[w][b];
+                counts[b] += partialCounts[w][b];
+            }
+        }
+
+        // 3. best-first growth over histogram ranges
+        std::priority_queue<Leaf> open;
+        std::vector<Leaf> done;
+        open.push(bestSplit(0, numPreBins, sums, counts, minSamplesLeaf));
+        while (!open.empty())
+        {
+            Leaf leaf = open.top();
+            open.pop();
+            if (leaf.gain <= 0.0 || open.size() + done.size() + 1 >= maxBins)
+            {
+                done.push_back(leaf);
+                continue;
+            }
+            open.push(bestSplit(leaf.first, leaf.split, sums, counts, minSamplesLeaf));
+            open.push(bestSplit(leaf.split, leaf.last, sums, counts, minSamplesLeaf));
+        }
+
+        std::sort(done.begin(), done.end(), [](const Leaf &lhs, const Leaf &rhs)
+                  { return lhs.first < rhs.first; });
+        for (const Leaf &leaf : done)
+        {
+            binEdges.push_back(preEdges[leaf.first]);
+            binCounts.push_back(std::accumulate(counts.begin() + leaf.first, counts.begin() + leaf.last, size_t(0)));
+        }
+        binEdges.push_back(preEdges.back());
+
+        cutter = BinCutter<T>(binEdges);
+    }
+
+    template <typename Code>
+    void cut(const T *input, size_t n, Code *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("decision_tree_binning.cut");
+        const ScopedOperation timing(metrics, n, n * sizeof(T));
+        cutter.cut(input, n, codes);
+    }
+
+    std::vector<size_t> cut(const std::vector<T> &input) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("decision_tree_binning.cut");
+        const ScopedOperation timing(metrics, input.size(), input.size() * sizeof(T));
+        return cutter.cut(input);
+    }
+
+    size_t getBinCount(size_t binIndex) const
+    {
+        if (binIndex >= binCounts.size())
+        {
+            throw std::out_of_range("Bin index out of range");
+        }
+        return binCounts[binIndex];
+    }
+
+    size_t getNumBins() const
+    {
+        return binCounts.size();
+    }
+
+    const std::vector<T> &getBinEdges() const
+    {
+        return binEdges;
+    }
+};
+
+// Fits one DecisionTreeBinning per column (columns[j] is feature j),
+// columns are spread across threads. Shapes are checked here first, naming
+// the column; a column a worker rejects (e.g. all NaN) is rethrown by
+// parallel_for.
+template <typename T>
+std::vector<DecisionTreeBinning<T>> fit_decision_tree_binning(const std::vector<std::vector<T>> &columns, const std::vector<double> &target,
+                                                              size_t max_bins, size_t min_samples_leaf = 1, size_t num_threads = 0)
+{
+    for (size_t j = 0; j < columns.size(); ++j)
+    {
+        if (columns[j].empty() || columns[j].size() != target.size())
+        {
+            throw std::invalid_argument("Column " + std::to_string(j) + " has " + std::to_string(columns[j].size()) + " values, target has " +
+                                        std::to_string(target.size()));
+        }
+    }
+
+    std::vector<std::optional<DecisionTreeBinning<T>>> fitted(columns.size());
+    parallel_for(
+        columns.size(),
+        [&](size_t begin, size_t end, size_t)
+        {
+            for (size_t j = begin; j < end; ++j)
+            {
+                fitted[j].emplace(columns[j], target, max_bins, min_samples_leaf, 255, 1);
+            }
+        },
+        num_threads, 1);
+
+    std::vector<DecisionTreeBinning<T>> result;
+    result.reserve(columns.size());
+    for (auto &binning : fitted)
+    {
+        result.push_back(std::move(*binning));
+    }
+    return result;
+}
@@ -0,0 +1,459 @@
+#pragma once
+
+#include "include_file.h"
+#include "Metrics.h"
+#include "Rcu.h"
+#include "Serialization.h"
+#include "SparseMatrix.h"
+#include "StringDictionary.h"
+
+// LABEL ENCODER
+// Backed by a flat StringDictionary: labels are interned once, lookups are
+// by std::string_view, codes are dense in first-seen order (duplicates in
+// fit do not leave gaps) and decode is a vector index. load maps a saved
+// vocabulary without copying it (see StringDictionary::load).
+template <typename T>
+class LabelEncoder
+{
+    static_assert(std::is_convertible_v<const T &, std::string_view>, "LabelEncoder labels must be string-like");
+
+private:
+    StringDictionary dictionary;
+
+public:
+    void fit(const std::vector<T> &labels)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("label_encoder.fit");
+        const ScopedOperation timing(metrics, labels.size());
+        for (const auto &label : labels)
+        {
+            dictionary.insert(label);
+        }
+    }
+
+    // Batch encode into a caller buffer; throws on the first unknown label
+    void encode(const T *labels, size_t n, int *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("label_encoder.encode");
+        const ScopedOperation timing(metrics, n);
+        static_assert(sizeof(int) == sizeof(uint32_t), "codes are written as uint32_t");
+        dictionary.findBatch(labels, n, reinterpret_cast<uint32_t *>(codes));
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (static_cast<uint32_t>(codes[i]) == StringDictionary::npos)
+            {
+                throw std::invalid_argument("Unknown label: " + std::string(std::string_view(labels[i])));
+            }
+        }
+    }
+
+    auto encode(const std::vector<T> &labels) const
+    {
+        std::vector<int> encoded_labels(labels.size());
+        encode(labels.data(), labels.size(), encoded_labels.data());
+        return encoded_labels;
+    }
+
+    auto decode(const std::vector<int> &encoded_labels) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("label_encoder.decode");
+        const ScopedOperation timing(metrics, encoded_labels.size());
+        std::vector<T> decoded_labels;
+        decoded_labels.reserve(encoded_labels.size());
+        for (int index : encoded_labels)
+        {
+            if (index < 0 || static_cast<size_t>(index) >= dictionary.size())
+            {
+                throw std::invalid_argument("Unknown index: " + std::to_string(index));
+            }
+            decoded_labels.emplace_back(dictionary.at(static_cast<uint32_t>(index)));
+        }
+        return decoded_labels;
+    }
+
+    size_t size() const
+    {
+        return dictionary.size();
+    }
+
+    void save(BinaryWriter &writer) const
+    {
+        writer.writeHeader(SerialKind::LabelEncoder, serial_type<T>());
+        dictionary.save(writer);
+    }
+
+    static LabelEncoder load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::LabelEncoder, serial_type<T>());
+        LabelEncoder encoder;
+        encoder.dictionary = StringDictionary::load(reader);
+        return encoder;
+    }
+};
+
+//  ONE HOT ENCODER WITH MULTI-COLINEARITY CHECK AND DUMMY VARIABLE TRAP CHECK AND DECODER
+// encode returns an index-only CSR matrix (one stored column per row), so
+// memory is O(rows) whatever the number of categories; encode_dense is the
+// opt-in dense rows x categories output.
+template <typename T>
+class OneHotEncoder
+{
+private:
+    StringDictionary dictionary;
+
+    void checkRow(size_t active, size_t row_size) const
+    {
+        if (row_size > 1)
+        {
+            throw std::invalid_argument("Multi-collinearity detected in one-hot encoding.");
+        }
+        if (row_size == 0)
+        {
+            throw std::invalid_argument("No active feature found in one-hot encoding.");
+        }
+        if (active >= dictionary.size())
+        {
+            throw std::invalid_argument("Unknown index: " + std::to_string(active));
+        }
+    }
+
+public:
+    void fit(const std::vector<std::string> &features)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("one_hot_encoder.fit");
+        const ScopedOperation timing(metrics, features.size());
+        for (const auto &feature : features)
+        {
+            dictionary.insert(feature);
+        }
+    }
+
+    CsrMatrix<int> encode(const std::vector<std::string> &features) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("one_hot_encoder.encode");
+        const ScopedOperation timing(metrics, features.size());
+        CsrMatrix<int> encoded_features;
+        encoded_features.rows = features.size();
+        encoded_features.cols = dictionary.size();
+        encoded_features.indices.resize(features.size());
+        dictionary.findBatch(features.data(), features.size(), encoded_features.indices.data());
+
+        encoded_features.indptr.resize(features.size() + 1);
+        for (size_t i = 0; i < features.size(); ++i)
+        {
+            if (encoded_features.indices[i] == StringDictionary::npos)
+            {
+                throw std::invalid_argument("Unknown feature: " + features[i]);
+            }
+            encoded_features.indptr[i + 1] = i + 1;
+        }
+        return encoded_features;
+    }
+
+    std::vector<std::vector<int>> encode_dense(const std::vector<std::string> &features) const
+    {
+        return encode(features).toDense();
+    }
+
+    // O(1) validation per row: exactly one stored entry, equal to 1
+    std::vector<std::string> decode(const CsrMatrix<int> &encoded_features) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("one_hot_encoder.decode");
+        const ScopedOperation timing(metrics, encoded_features.rows);
+        std::vector<std::string> decoded_features;
+        decoded_features.reserve(encoded_features.rows);
+        for (size_t i = 0; i < encoded_features.rows; ++i)
+        {
+            const size_t first = encoded_features.indptr[i];
+            const size_t row_size = encoded_features.rowSize(i);
+            checkRow(row_size == 1 ? encoded_features.indices[first] : 0, row_size);
+            if (encoded_features.value(first) != 1)
+            {
+                throw std::invalid_argument("No active feature found in one-hot encoding.");
+            }
+            decoded_features.emplace_back(dictionary.at(encoded_features.indices[first]));
+        }
+        return decoded_features;
+    }
+
+    std::vector<std::string> decode(const std::vector<std::vector<int>> &encoded_features) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("one_hot_encoder.decode");
+        const ScopedOperation timing(metrics, encoded_features.size());
+        std::vector<std::string> decoded_features;
+        decoded_features.reserve(encoded_features.size());
+        for (const auto &encoded_feature : encoded_features)
+        {
+            size_t active_index = 0;
+            size_t active_count = 0;
+            for (size_t i = 0; i < encoded_feature.size(); ++i)
+            {
+                if (encoded_feature[i] == 1)
+                {
+                    active_index = i;
+                    active_count++;
+                }
+            }
+            checkRow(active_index, active_count);
+            decoded_features.emplace_back(dictionary.at(static_cast<uint32_t>(active_index)));
+        }
+        return decoded_features;
+    }
+
+    size_t size() const
+    {
+        return dictionary.size();
+    }
+
+    void save(BinaryWriter &writer) const
+    {
+        writer.writeHeader(SerialKind::OneHotEncoder, serial_type<T>());
+        dictionary.save(writer);
+    }
+
+    static OneHotEncoder load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::OneHotEncoder, serial_type<T>());
+        OneHotEncoder encoder;
+        encoder.dictionary = StringDictionary::load(reader);
+        return encoder;
+    }
+};
+
+// CONCURRENT ENCODERS
+// For serving: many threads encode while a background job adds newly seen
+// categories. The vocabulary is an RcuPointer<StringDictionary> snapshot, so
+// encode/decode never lock and every batch sees one consistent vocabulary;
+// add() copies the dictionary, inserts the new labels and publishes the copy.
+// Codes are append-only, so a code handed out by an older snapshot decodes
+// the same under every newer one. Adding in batches amortises the copy.
+enum class UnknownPolicy
+{
+    Throw,         // unknown labels throw std::invalid_argument
+    UnknownBucket, // unknown labels get the reserved code 0, known labels start at 1
+};
+
+class ConcurrentVocabulary
+{
+private:
+    RcuPointer<StringDictionary> dictionary;
+    UnknownPolicy policy;
+
+public:
+    static constexpr std::string_view unknown_label = "<unknown>";
+
+    explicit ConcurrentVocabulary(UnknownPolicy unknown_policy) : policy(unknown_policy) {}
+
+    uint32_t offset() const
+    {
+        return policy == UnknownPolicy::UnknownBucket ? 1 : 0;
+    }
+
+    template <typename T>
+    void add(const T *labels, size_t n)
+    {
+        {
+            // common case in serving: nothing new, no copy and no writer lock
+            auto snapshot = dictionary.read();
+            size_t i = 0;
+            while (i < n && snapshot->contains(labels[i]))
+            {
+                ++i;
+            }
+            if (i == n)
+            {
+                return;
+            }
+        }
+        dictionary.update([&](StringDictionary &next)
+                          {
+                              // size the copy by the distinct keys it lacks, not
+                              // by the batch length (batches repeat labels)
+                              StringDictionary missing;
+                              for (size_t i = 0; i < n; ++i)
+                              {
+                                  if (!next.contains(labels[i]))
+                                  {
+                                      missing.insert(labels[i]);
+                                  }
+                              }
+                              next.reserve(next.size() + missing.size());
+                              for (uint32_t code = 0; code < missing.size(); ++code)
+                              {
+                                  next.insert(missing.at(code));
+                              } });
+    }
+
+    // Writes the codes of labels under one snapshot; returns the number of
+    // columns (known labels plus the unknown bucket) of that snapshot
+    template <typename T>
+    size_t lookup(const T *labels, size_t n, uint32_t *codes) const
+    {
+        auto snapshot = dictionary.read();
+        snapshot->findBatch(labels, n, codes);
+        const uint32_t shift = offset();
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (codes[i] != StringDictionary::npos)
+            {
+                codes[i] += shift;
+            }
+            else if (policy == UnknownPolicy::Throw)
+            {
+                throw std::invalid_argument("Unknown label: " + std::string(std::string_view(labels[i])));
+            }
+            else
+            {
+                codes[i] = 0;
+            }
+        }
+        return snapshot->size() + shift;
+    }
+
+    template <typename T>
+    std::vector<T> labels(const uint32_t *codes, size_t n) const
+    {
+        auto snapshot = dictionary.read();
+        const uint32_t shift = offset();
+        std::vector<T> decoded;
+        decoded.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (shift == 1 && codes[i] == 0)
+            {
+                decoded.emplace_back(unknown_label);
+            }
+            else if (codes[i] < shift || codes[i] - shift >= snapshot->size())
+            {
+                throw std::invalid_argument("Unknown index: " + std::to_string(codes[i]));
+            }
+            else
+            {
+                decoded.emplace_back(snapshot->at(codes[i] - shift));
+            }
+        }
+        return decoded;
+    }
+
+    size_t size() const
+    {
+        return dictionary.read()->size();
+    }
+};
+
+template <typename T>
+class ConcurrentLabelEncoder
+{
+    static_assert(std::is_convertible_v<const T &, std::string_view>, "ConcurrentLabelEncoder labels must be string-like");
+
+private:
+    ConcurrentVocabulary vocabulary;
+
+public:
+    explicit ConcurrentLabelEncoder(UnknownPolicy policy = UnknownPolicy::Throw) : vocabulary(policy) {}
+
+    // Safe to call while other threads encode
+    void add(const T *labels, size_t n)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("concurrent_label_encoder.add");
+        const ScopedOperation timing(metrics, n);
+        vocabulary.add(labels, n);
+    }
+
+    void fit(const std::vector<T> &labels)
+    {
+        add(labels.data(), labels.size());
+    }
+
+    void encode(const T *labels, size_t n, int *codes) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("concurrent_label_encoder.encode");
+        const ScopedOperation timing(metrics, n);
+        static_assert(sizeof(int) == sizeof(uint32_t), "codes are written as uint32_t");
+        vocabulary.lookup(labels, n, reinterpret_cast<uint32_t *>(codes));
+    }
+
+    std::vector<int> encode(const std::vector<T> &labels) const
+    {
+        std::vector<int> encoded_labels(labels.size());
+        encode(labels.data(), labels.size(), encoded_labels.data());
+        return encoded_labels;
+    }
+
+    std::vector<T> decode(const std::vector<int> &encoded_labels) const
+    {
+        for (int index : encoded_labels)
+        {
+            if (index < 0)
+            {
+                throw std::invalid_argument("Unknown index: " + std::to_string(index));
+            }
+        }
+        return vocabulary.labels<T>(reinterpret_cast<const uint32_t *>(encoded_labels.data()), encoded_labels.size());
+    }
+
+    // Known labels, not counting the unknown bucket
+    size_t size() const
+    {
+        return vocabulary.size();
+    }
+};
+
+// With UnknownPolicy::UnknownBucket column 0 is the unknown column
+template <typename T>
+class ConcurrentOneHotEncoder
+{
+private:
+    ConcurrentVocabulary vocabulary;
+
+public:
+    explicit ConcurrentOneHotEncoder(UnknownPolicy policy = UnknownPolicy::Throw) : vocabulary(policy) {}
+
+    // Safe to call while other threads encode
+    void add(const T *features, size_t n)
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("concurrent_one_hot_encoder.add");
+        const ScopedOperation timing(metrics, n);
+        vocabulary.add(features, n);
+    }
+
+    void fit(const std::vector<T> &features)
+    {
+        add(features.data(), features.size());
+    }
+
+    CsrMatrix<int> encode(const std::vector<T> &features) const
+    {
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("concurrent_one_hot_encoder.encode");
+        const ScopedOperation timing(metrics, features.size());
+        CsrMatrix<int> encoded_features;
+        encoded_features.rows = features.size();
+        encoded_features.indices.resize(features.size());
+        encoded_features.cols = vocabulary.lookup(features.data(), features.size(), encoded_features.indices.data());
+        encoded_features.indptr.resize(features.size() + 1);
+        std::iota(encoded_features.indptr.begin(), encoded_features.indptr.end(), size_t(0));
+        return encoded_features;
+    }
+
+    std::vector<T> decode(const CsrMatrix<int> &encoded_features) const
+    {
+        for (size_t i = 0; i < encoded_features.rows; ++i)
+        {
+            if (encoded_features.rowSize(i) != 1 || encoded_features.value(encoded_features.indptr[i]) != 1)
+            {
+                throw std::invalid_argument("Expected exactly one active feature per row.");
+            }
+        }
+        std::vector<uint32_t> active(encoded_features.rows);
+        for (size_t i = 0; i < encoded_features.rows; ++i)
+        {
+            active[i] = encoded_features.indices[encoded_features.indptr[i]];
+        }
+        return vocabulary.labels<T>(active.data(), active.size());
+    }
+
+    size_t size() const
+    {
+        return vocabulary.size();
+    }
+};
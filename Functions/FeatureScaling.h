@@ -0,0 +1,149 @@
+#pragma once
+
+#include "include_file.h"
+#include "Arena.h"
+#include "Metrics.h"
+#include "Precision.h"
+#include "Serialization.h"
+
+// Standard scaling of row-major features. T is the storage type; the
+// statistics are accumulated in double and transform writes scaled_t<T>
+// (float stays float, see Precision.h). Rows can be std::vector or
+// std::pmr::vector; the memory_resource overloads take fit scratch and
+// transform results from the given resource (e.g. a per-batch BumpArena),
+// and the flat transform writes into a caller buffer without allocating.
+// fit and transform are recorded as feature_scaler.fit / .transform (Metrics.h).
+template <typename T = double>
+class FeatureScaler {
+private:
+    using R = scaled_t<T>;
+
+    std::vector<double> minValues;
+    std::vector<double> maxValues;
+    std::vector<double> meanValues;
+    std::vector<double> stdDevValues;
+    std::vector<R> scaledMeans; // meanValues / stdDevValues in the output type
+    std::vector<R> scaledStdDevs;
+    bool isFitted;
+
+    void prepareScaling() {
+        scaledMeans.assign(meanValues.begin(), meanValues.end());
+        scaledStdDevs.assign(stdDevValues.begin(), stdDevValues.end());
+    }
+
+    static OperationMetrics& transformMetrics() {
+        static OperationMetrics& metrics = MetricsRegistry::global().operation("feature_scaler.transform");
+        return metrics;
+    }
+
+    void transformRow(const T* row, R* scaled) const {
+        const R* means = scaledMeans.data();
+        const R* stdDevs = scaledStdDevs.data();
+        for (size_t j = 0; j < scaledMeans.size(); ++j) {
+            scaled[j] = (static_cast<R>(row[j]) - means[j]) / stdDevs[j];
+        }
+    }
+
+public:
+    FeatureScaler() : isFitted(false) {}
+
+    template <typename Row, typename Alloc>
+    void fit(const std::vector<Row, Alloc>& features, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        size_t numFeatures = features[0].size();
+        static OperationMetrics& metrics = MetricsRegistry::global().operation("feature_scaler.fit");
+        const ScopedOperation timing(metrics, features.size(), features.size() * numFeatures * sizeof(T));
+        minValues.resize(numFeatures);
+        maxValues.resize(numFeatures);
+        meanValues.resize(numFeatures);
+        stdDevValues.resize(numFeatures);
+
+        std::pmr::vector<double> column(features.size(), resource);
+        for (size_t i = 0; i < numFeatures; ++i) {
+            for (size_t r = 0; r < features.size(); ++r) {
+                column[r] = static_cast<double>(features[r][i]);
+            }
+
+            minValues[i] = *std::min_element(column.begin(), column.end());
+            maxValues[i] = *std::max_element(column.begin(), column.end());
+            meanValues[i] = std::accumulate(column.begin(), column.end(), 0.0) / column.size();
+
+            double variance = 0.0;
+            for (double val : column) {
+                variance += (val - meanValues[i]) * (val - meanValues[i]);
+            }
+            variance /= column.size();
+            stdDevValues[i] = std::sqrt(variance);
+        }
+
+        prepareScaling();
+        isFitted = true;
+    }
+
+    // input / output: rows x number of features, row-major
+    void transform(const T* input, size_t rows, R* output) const {
+        if (!isFitted) {
+            throw std::logic_error("Scaler has not been fitted. Call fit method first.");
+        }
+        const size_t numFeatures = scaledMeans.size();
+        const ScopedOperation timing(transformMetrics(), rows, rows * numFeatures * sizeof(T));
+        for (size_t i = 0; i < rows; ++i) {
+            transformRow(input + i * numFeatures, output + i * numFeatures);
+        }
+    }
+
+    template <typename Row, typename Alloc>
+    std::vector<std::vector<R>> transform(const std::vector<Row, Alloc>& features) const {
+        if (!isFitted) {
+            std::cerr << "Scaler has not been fitted. Call fit method first." << std::endl;
+            return {};
+        }
+
+        const ScopedOperation timing(transformMetrics(), features.size(), features.size() * scaledMeans.size() * sizeof(T));
+        std::vector<std::vector<R>> scaledFeatures(features.size(), std::vector<R>(scaledMeans.size()));
+
+        for (size_t i = 0; i < features.size(); ++i) {
+            transformRow(features[i].data(), scaledFeatures[i].data());
+        }
+
+        return scaledFeatures;
+    }
+
+    // Rows allocated from resource: with a BumpArena, no heap allocation
+    template <typename Row, typename Alloc>
+    std::pmr::vector<std::pmr::vector<R>> transform(const std::vector<Row, Alloc>& features, std::pmr::memory_resource* resource) const {
+        if (!isFitted) {
+            throw std::logic_error("Scaler has not been fitted. Call fit method first.");
+        }
+
+        const ScopedOperation timing(transformMetrics(), features.size(), features.size() * scaledMeans.size() * sizeof(T));
+        std::pmr::vector<std::pmr::vector<R>> scaledFeatures(resource);
+        scaledFeatures.reserve(features.size());
+        for (size_t i = 0; i < features.size(); ++i) {
+            scaledFeatures.emplace_back(scaledMeans.size()); // row shares the outer allocator
+            transformRow(features[i].data(), scaledFeatures.back().data());
+        }
+
+        return scaledFeatures;
+    }
+
+    void save(BinaryWriter& writer) const {
+        writer.writeHeader(SerialKind::FeatureScaler, serial_type<T>());
+        writer.write<uint8_t>(isFitted);
+        writer.writeArray(minValues);
+        writer.writeArray(maxValues);
+        writer.writeArray(meanValues);
+        writer.writeArray(stdDevValues);
+    }
+
+    static FeatureScaler load(BinaryReader& reader) {
+        reader.readHeader(SerialKind::FeatureScaler, serial_type<T>());
+        FeatureScaler scaler;
+        scaler.isFitted = reader.read<uint8_t>() != 0;
+        scaler.minValues = reader.readVector<double>();
+        scaler.maxValues = reader.readVector<double>();
+        scaler.meanValues = reader.readVector<double>();
+        scaler.stdDevValues = reader.readVector<double>();
+        scaler.prepareScaling();
+        return scaler;
+    }
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "include_file.h"
+
+// XXH64 (xxHash, 64-bit variant), seedable.
+// Unlike std::hash the result is fixed by the algorithm, so it is identical
+// across compilers, standard libraries and machines; bytes are always read
+// little-endian. Anything persisted or shared between processes (hashed
+// features, dictionary slot tables) relies on that.
+
+namespace xxh64_detail
+{
+    constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+    inline uint64_t rotl(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t read64(const unsigned char *p)
+    {
+        uint64_t v = 0;
+        for (int i = 7; i >= 0; --i)
+        {
+            v = (v << 8) | p[i];
+        }
+        return v;
+    }
+
+    inline uint32_t read32(const unsigned char *p)
+    {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * prime2;
+        acc = rotl(acc, 31);
+        return acc * prime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t value)
+    {
+        acc ^= round(0, value);
+        return acc * prime1 + prime4;
+    }
+}
+
+inline uint64_t xxh64(const void *input, size_t length, uint64_t seed = 0)
+{
+    using namespace xxh64_detail;
+
+    const unsigned char *p = static_cast<const unsigned char *>(input);
+    const unsigned char *const end = p + length;
+    uint64_t h;
+
+    if (length >= 32)
+    {
+        uint64_t v1 = seed + prime1 + prime2;
+        uint64_t v2 = seed + prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - prime1;
+        const unsigned char *const limit = end - 32;
+        do
+        {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    }
+    else
+    {
+        h = seed + prime5;
+    }
+
+    h += static_cast<uint64_t>(length);
+
+    while (p + 8 <= end)
+    {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * prime1 + prime4;
+        p += 8;
+    }
+    if (p + 4 <= end)
+    {
+        h ^= static_cast<uint64_t>(read32(p)) * prime1;
+        h = rotl(h, 23) * prime2 + prime3;
+        p += 4;
+    }
+    while (p < end)
+    {
+        h ^= static_cast<uint64_t>(*p) * prime5;
+        h = rotl(h, 11) * prime1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline uint64_t xxh64(std::string_view text, uint64_t seed = 0)
+{
+    return xxh64(text.data(), text.size(), seed);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "include_file.h"
+#include "Hash.h"
+#include "Parallel.h"
+#include "SparseMatrix.h"
+
+// Hashing trick for bags of tokens (like sklearn's HashingVectorizer).
+//
+// Each token goes to column xxh64(token, seed) mod numFeatures. XXH64 is
+// fixed by its spec, so the same token lands in the same column on every
+// machine and build, unlike std::hash. With alternateSign the top hash bit
+// picks +1 or -1, so colliding tokens cancel in expectation instead of
+// piling up (the signed-hash trick).
+//
+// transform takes many rows per call, shards them over threads and returns
+// a CSR matrix; duplicates within a row are summed and exact zeros dropped,
+// so a 2^20-wide feature space costs only the stored entries.
+class HashingVectorizer
+{
+private:
+    size_t numFeatures;
+    uint64_t seed;
+    bool alternateSign;
+    bool powerOfTwo;
+
+    struct Entry
+    {
+        uint32_t index;
+        double value;
+    };
+
+    template <typename Token>
+    void hashRow(const std::vector<Token> &row, std::vector<Entry> &scratch,
+                 std::vector<uint32_t> &indices, std::vector<double> &values) const
+    {
+        scratch.clear();
+        for (const auto &token : row)
+        {
+            const uint64_t h = hash(token);
+            scratch.push_back(Entry{column(h), sign(h)});
+        }
+        std::sort(scratch.begin(), scratch.end(), [](const Entry &a, const Entry &b)
+                  { return a.index < b.index; });
+
+        for (size_t i = 0; i < scratch.size();)
+        {
+            const uint32_t index = scratch[i].index;
+            double sum = 0.0;
+            for (; i < scratch.size() && scratch[i].index == index; ++i)
+            {
+                sum += scratch[i].value;
+            }
+            if (sum != 0.0)
+            {
+                indices.push_back(index);
+                values.push_back(sum);
+            }
+        }
+    }
+
+public:
+    explicit HashingVectorizer(size_t num_features = size_t(1) << 20, uint64_t hash_seed = 0, bool alternate_sign = true)
+        : numFeatures(num_features), seed(hash_seed), alternateSign(alternate_sign)
+    {
+        if (numFeatures == 0 || numFeatures > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::invalid_argument("Number of features must be in [1, 2^32 - 1]");
+        }
+        powerOfTwo = (numFeatures & (numFeatures - 1)) == 0;
+    }
+
+    uint64_t hash(std::string_view token) const
+    {
+        return xxh64(token, seed);
+    }
+
+    uint32_t column(uint64_t h) const
+    {
+        return static_cast<uint32_t>(powerOfTwo ? h & (numFeatures - 1) : h % numFeatures);
+    }
+
+    double sign(uint64_t h) const
+    {
+        return alternateSign && (h >> 63) != 0 ? -1.0 : 1.0;
+    }
+
+    // One bag of tokens per row; Token is any type convertible to std::string_view
+    template <typename Token>
+    CsrMatrix<double> transform(const std::vector<std::vector<Token>> &rows, size_t num_threads = 0) const
+    {
+        struct Shard
+        {
+            std::vector<uint32_t> indices;
+            std::vector<double> values;
+        };
+
+        CsrMatrix<double> hashed;
+        hashed.rows = rows.size();
+        hashed.cols = numFeatures;
+        hashed.indptr.assign(rows.size() + 1, 0);
+
+        const size_t min_rows = 256;
+        std::vector<Shard> shards(parallel_workers(rows.size(), num_threads, min_rows));
+        parallel_for(
+            rows.size(), [&](size_t begin, size_t end, size_t worker)
+            {
+                Shard &shard = shards[worker];
+                std::vector<Entry> scratch;
+                for (size_t r = begin; r < end; ++r)
+                {
+                    const size_t before = shard.indices.size();
+                    hashRow(rows[r], scratch, shard.indices, shard.values);
+                    hashed.indptr[r + 1] = shard.indices.size() - before;
+                } },
+            num_threads, min_rows);
+
+        // shards hold consecutive row ranges in worker order, so the row
+        // counts prefix-sum straight into offsets of the concatenation
+        std::partial_sum(hashed.indptr.begin(), hashed.indptr.end(), hashed.indptr.begin());
+
+        hashed.indices.reserve(hashed.indptr.back());
+        hashed.values.reserve(hashed.indptr.back());
+        for (Shard &shard : shards)
+        {
+            hashed.indices.insert(hashed.indices.end(), shard.indices.begin(), shard.indices.end());
+            hashed.values.insert(hashed.values.end(), shard.values.begin(), shard.values.end());
+        }
+        return hashed;
+    }
+
+    size_t getNumFeatures() const
+    {
+        return numFeatures;
+    }
+};
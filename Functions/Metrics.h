@@ -0,0 +1,324 @@
+#pragma once
+
+#include "include_file.h"
+#include "array"
+#include "chrono"
+#include "sstream"
+
+// Always-on counters for the preprocessing operations.
+//
+// Every instrumented fit / transform records, per operation name: calls,
+// rows and bytes processed, heap allocations made on the calling thread, and
+// a latency histogram (power-of-two nanosecond buckets). The counters live in
+// OperationMetrics, split into cache-line sized shards; a thread always adds
+// to the same shard with relaxed atomics, so concurrent callers do not
+// contend on one line and a record costs two clock reads plus a few
+// uncontended adds per call (never per row).
+//
+// MetricsRegistry::global().snapshot() sums the shards into plain structs;
+// exposition() renders them in the Prometheus text format. Allocation
+// counts need a program-wide operator new that calls
+// metrics_count_allocation(); without one they stay 0.
+//
+// Instrumented code keeps a reference to its OperationMetrics in a
+// function-local static and wraps the work in a ScopedOperation:
+//   static OperationMetrics &metrics = MetricsRegistry::global().operation("feature_scaler.transform");
+//   ScopedOperation timing(metrics, rows, bytes);
+
+struct ThreadAllocations
+{
+    uint64_t calls = 0;
+    uint64_t bytes = 0;
+};
+
+inline thread_local ThreadAllocations metrics_thread_allocations;
+
+// For a replaced operator new; counts towards the operations running on
+// this thread
+inline void metrics_count_allocation(size_t bytes)
+{
+    ++metrics_thread_allocations.calls;
+    metrics_thread_allocations.bytes += bytes;
+}
+
+struct OperationSnapshot
+{
+    static constexpr size_t latencyBuckets = 40;
+
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t rows = 0;
+    uint64_t bytes = 0;
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t nanoseconds = 0;
+    // latency[k]: calls that took [2^k, 2^(k+1)) ns; the last bucket is open
+    std::array<uint64_t, latencyBuckets> latency{};
+
+    // Upper bound of the bucket holding quantile q of the call latencies
+    double latencyQuantileSeconds(double q) const
+    {
+        const double target = q * static_cast<double>(calls);
+        uint64_t seen = 0;
+        for (size_t k = 0; k < latencyBuckets; ++k)
+        {
+            seen += latency[k];
+            if (seen > 0 && static_cast<double>(seen) >= target)
+            {
+                return std::ldexp(1.0, static_cast<int>(k) + 1) * 1e-9;
+            }
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+};
+
+class OperationMetrics
+{
+private:
+    static constexpr size_t numShards = 16;
+
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> rows{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> allocatedBytes{0};
+        std::atomic<uint64_t> nanoseconds{0};
+        std::atomic<uint64_t> latency[OperationSnapshot::latencyBuckets] = {};
+    };
+
+    std::string operationName;
+    std::unique_ptr<Shard[]> shards;
+
+    static size_t threadShard()
+    {
+        static std::atomic<size_t> nextThread{0};
+        thread_local const size_t shard = nextThread.fetch_add(1, std::memory_order_relaxed) % numShards;
+        return shard;
+    }
+
+public:
+    explicit OperationMetrics(std::string name) : operationName(std::move(name)), shards(new Shard[numShards]) {}
+
+    const std::string &name() const
+    {
+        return operationName;
+    }
+
+    void record(uint64_t rows, uint64_t bytes, uint64_t nanoseconds, uint64_t allocations = 0, uint64_t allocated_bytes = 0)
+    {
+        Shard &shard = shards[threadShard()];
+        shard.calls.fetch_add(1, std::memory_order_relaxed);
+        shard.rows.fetch_add(rows, std::memory_order_relaxed);
+        shard.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        shard.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        if (allocations != 0)
+        {
+            shard.allocations.fetch_add(allocations, std::memory_order_relaxed);
+            shard.allocatedBytes.fetch_add(allocated_bytes, std::memory_order_relaxed);
+        }
+        const size_t bucket = nanoseconds == 0 ? 0 : std::min<size_t>(63 - __builtin_clzll(nanoseconds), OperationSnapshot::latencyBuckets - 1);
+        shard.latency[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Sum over the shards; concurrent records may or may not be included
+    OperationSnapshot snapshot() const
+    {
+        OperationSnapshot total;
+        total.name = operationName;
+        for (size_t s = 0; s < numShards; ++s)
+        {
+            const Shard &shard = shards[s];
+            total.calls += shard.calls.load(std::memory_order_relaxed);
+            total.rows += shard.rows.load(std::memory_order_relaxed);
+            total.bytes += shard.bytes.load(std::memory_order_relaxed);
+            total.allocations += shard.allocations.load(std::memory_order_relaxed);
+            total.allocatedBytes += shard.allocatedBytes.load(std::memory_order_relaxed);
+            total.nanoseconds += shard.nanoseconds.load(std::memory_order_relaxed);
+            for (size_t k = 0; k < OperationSnapshot::latencyBuckets; ++k)
+            {
+                total.latency[k] += shard.latency[k].load(std::memory_order_relaxed);
+            }
+        }
+        return total;
+    }
+
+    void reset()
+    {
+        for (size_t s = 0; s < numShards; ++s)
+        {
+            Shard &shard = shards[s];
+            for (std::atomic<uint64_t> *counter : {&shard.calls, &shard.rows, &shard.bytes, &shard.allocations, &shard.allocatedBytes, &shard.nanoseconds})
+            {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (std::atomic<uint64_t> &bucket : shard.latency)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+class MetricsRegistry
+{
+private:
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<OperationMetrics>> operations; // never shrinks, so references stay valid
+    std::atomic<bool> enabled{true};
+
+    static void appendLabelled(std::ostringstream &out, const char *metric, const std::string &name, uint64_t value)
+    {
+        out << "ml_functions_" << metric << "{operation=\"" << name << "\"} " << value << "\n";
+    }
+
+public:
+    static MetricsRegistry &global()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    // Counters for name, created on first use
+    OperationMetrics &operation(std::string_view name)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<OperationMetrics> &existing : operations)
+        {
+            if (existing->name() == name)
+            {
+                return *existing;
+            }
+        }
+        operations.push_back(std::make_unique<OperationMetrics>(std::string(name)));
+        return *operations.back();
+    }
+
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // Turns recording off (ScopedOperation then skips its clock reads)
+    void setEnabled(bool on)
+    {
+        enabled.store(on, std::memory_order_relaxed);
+    }
+
+    std::vector<OperationSnapshot> snapshot() const
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        std::vector<OperationSnapshot> snapshots;
+        snapshots.reserve(operations.size());
+        for (const std::unique_ptr<OperationMetrics> &metrics : operations)
+        {
+            snapshots.push_back(metrics->snapshot());
+        }
+        std::sort(snapshots.begin(), snapshots.end(), [](const OperationSnapshot &a, const OperationSnapshot &b)
+                  { return a.name < b.name; });
+        return snapshots;
+    }
+
+    void reset()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<OperationMetrics> &metrics : operations)
+        {
+            metrics->reset();
+        }
+    }
+
+    // Prometheus text exposition format; operations never called are left out
+    std::string exposition() const
+    {
+        const std::vector<OperationSnapshot> snapshots = snapshot();
+        std::ostringstream out;
+        const std::pair<const char *, uint64_t OperationSnapshot::*> counters[] = {
+            {"calls_total", &OperationSnapshot::calls},
+            {"rows_total", &OperationSnapshot::rows},
+            {"bytes_total", &OperationSnapshot::bytes},
+            {"allocations_total", &OperationSnapshot::allocations},
+            {"allocated_bytes_total", &OperationSnapshot::allocatedBytes},
+        };
+        for (const auto &[metric, field] : counters)
+        {
+            out << "# TYPE ml_functions_" << metric << " counter\n";
+            for (const OperationSnapshot &operation : snapshots)
+            {
+                if (operation.calls > 0)
+                {
+                    appendLabelled(out, metric, operation.name, operation.*field);
+                }
+            }
+        }
+        out << "# TYPE ml_functions_latency_seconds histogram\n";
+        for (const OperationSnapshot &operation : snapshots)
+        {
+            if (operation.calls == 0)
+            {
+                continue;
+            }
+            uint64_t cumulative = 0;
+            for (size_t k = 0; k + 1 < OperationSnapshot::latencyBuckets; ++k)
+            {
+                cumulative += operation.latency[k];
+                out << "ml_functions_latency_seconds_bucket{operation=\"" << operation.name << "\",le=\""
+                    << std::ldexp(1.0, static_cast<int>(k) + 1) * 1e-9 << "\"} " << cumulative << "\n";
+            }
+            out << "ml_functions_latency_seconds_bucket{operation=\"" << operation.name << "\",le=\"+Inf\"} " << operation.calls << "\n";
+            out << "ml_functions_latency_seconds_sum{operation=\"" << operation.name << "\"} " << operation.nanoseconds * 1e-9 << "\n";
+            out << "ml_functions_latency_seconds_count{operation=\"" << operation.name << "\"} " << operation.calls << "\n";
+        }
+        return out.str();
+    }
+};
+
+// Records one call into metrics when it goes out of scope (also when the
+// operation throws). Rows and bytes can be set later, once they are known.
+class ScopedOperation
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    OperationMetrics *metrics;
+    uint64_t rows;
+    uint64_t bytes;
+    Clock::time_point start;
+    ThreadAllocations allocationsAtStart;
+
+public:
+    ScopedOperation(OperationMetrics &operation, uint64_t num_rows = 0, uint64_t num_bytes = 0)
+        : metrics(MetricsRegistry::global().isEnabled() ? &operation : nullptr), rows(num_rows), bytes(num_bytes)
+    {
+        if (metrics != nullptr)
+        {
+            allocationsAtStart = metrics_thread_allocations;
+            start = Clock::now();
+        }
+    }
+
+    ScopedOperation(const ScopedOperation &) = delete;
+    ScopedOperation &operator=(const ScopedOperation &) = delete;
+
+    ~ScopedOperation()
+    {
+        if (metrics == nullptr)
+        {
+            return;
+        }
+        const uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        const ThreadAllocations &now = metrics_thread_allocations;
+        metrics->record(rows, bytes, elapsed, now.calls - allocationsAtStart.calls, now.bytes - allocationsAtStart.bytes);
+    }
+
+    void setRows(uint64_t num_rows)
+    {
+        rows = num_rows;
+    }
+
+    void setBytes(uint64_t num_bytes)
+    {
+        bytes = num_bytes;
+    }
+};
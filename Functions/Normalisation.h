@@ -0,0 +1,157 @@
+#pragma once
+
+#include "include_file.h"
+#include "Arena.h"
+#include "Precision.h"
+
+// All four take any arithmetic storage type and return scaled_t<T>: float
+// data is scaled in float, anything else in double. Means and sums of squares
+// are accumulated in double in every case.
+// Each comes in three forms: a kernel writing into a caller buffer (no
+// allocation), a std::vector overload, and an overload that allocates the
+// result from a std::pmr::memory_resource (e.g. a per-batch BumpArena).
+// Inputs can be std::vector or std::pmr::vector.
+
+// Min-Max Normalisation z = (x - min) / (max - min)
+template <typename T>
+void min_max_normalisation(const T *data, size_t n, scaled_t<T> *normalized_data)
+{
+    using R = scaled_t<T>;
+    // double min = *std::min_element(data.begin(), data.end());
+    // double max = *std::max_element(data.begin(), data.end());
+    const auto [min, max] = std::minmax_element(data, data + n);
+
+    const R low = static_cast<R>(*min);
+    const R range = static_cast<R>(static_cast<double>(*max) - static_cast<double>(*min));
+    for (size_t i = 0; i < n; ++i)
+    {
+        normalized_data[i] = (static_cast<R>(data[i]) - low) / range;
+    };
+}
+
+// Standardisation (Standard Scaler) z = (x - mean) / stdev
+template <typename T>
+void standardisation(const T *data, size_t n, scaled_t<T> *standardized_data)
+{
+    using R = scaled_t<T>;
+    double sum = 0.0;
+    double sq_sum = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += static_cast<double>(data[i]);
+        sq_sum += static_cast<double>(data[i]) * static_cast<double>(data[i]);
+    }
+    const double mean = sum / n;
+    const double stdev = std::sqrt(sq_sum / n - mean * mean);
+
+    /*
+        std::vector<double>::iterator it;
+        for (it = data.begin(); it != data.end(); it++) {
+            *it = (*it - mean) / stdev;
+        };
+    */
+
+    std::transform(data, data + n, standardized_data,
+                   [mean = static_cast<R>(mean), stdev = static_cast<R>(stdev)](const auto &value)
+                   { return (static_cast<R>(value) - mean) / stdev; });
+}
+
+// MAX-ABS Normalisation z = x / max(abs(x))
+// used in sparse data and image processing , where data is already centered at zero ( where there is more zero values )
+template <typename T>
+void max_abs_normalisation(const T *data, size_t n, scaled_t<T> *normalized_data)
+{
+    using R = scaled_t<T>;
+    const auto max_abs = std::max_element(data, data + n, [](const auto &lhs, const auto &rhs)
+                                          { return std::abs(lhs) < std::abs(rhs); });
+
+    const R scale = static_cast<R>(std::abs(*max_abs));
+    for (size_t i = 0; i < n; ++i)
+    {
+        normalized_data[i] = static_cast<R>(data[i]) / scale;
+    };
+}
+
+// MEAN Normalisation z = (x - mean) / (max - min)
+template <typename T>
+void mean_normalisation(const T *data, size_t n, scaled_t<T> *normalized_data)
+{
+    using R = scaled_t<T>;
+    const double mean = std::accumulate(data, data + n, 0.0,
+                                        [](double sum, const T &value)
+                                        { return sum + static_cast<double>(value); }) /
+                        n;
+    const auto [min, max] = std::minmax_element(data, data + n);
+
+    const R center = static_cast<R>(mean);
+    const R range = static_cast<R>(static_cast<double>(*max) - static_cast<double>(*min));
+    for (size_t i = 0; i < n; ++i)
+    {
+        normalized_data[i] = (static_cast<R>(data[i]) - center) / range;
+    };
+}
+
+// Container forms of the four kernels above
+template <typename T, typename Alloc>
+std::vector<scaled_t<T>> min_max_normalisation(const std::vector<T, Alloc> &data)
+{
+    std::vector<scaled_t<T>> normalized_data(data.size());
+    min_max_normalisation(data.data(), data.size(), normalized_data.data());
+    return normalized_data;
+}
+
+template <typename T, typename Alloc>
+std::pmr::vector<scaled_t<T>> min_max_normalisation(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<scaled_t<T>> normalized_data(data.size(), resource);
+    min_max_normalisation(data.data(), data.size(), normalized_data.data());
+    return normalized_data;
+}
+
+template <typename T, typename Alloc>
+std::vector<scaled_t<T>> standardisation(const std::vector<T, Alloc> &data)
+{
+    std::vector<scaled_t<T>> standardized_data(data.size());
+    standardisation(data.data(), data.size(), standardized_data.data());
+    return standardized_data;
+}
+
+template <typename T, typename Alloc>
+std::pmr::vector<scaled_t<T>> standardisation(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<scaled_t<T>> standardized_data(data.size(), resource);
+    standardisation(data.data(), data.size(), standardized_data.data());
+    return standardized_data;
+}
+
+template <typename T, typename Alloc>
+std::vector<scaled_t<T>> max_abs_normalisation(const std::vector<T, Alloc> &data)
+{
+    std::vector<scaled_t<T>> normalized_data(data.size());
+    max_abs_normalisation(data.data(), data.size(), normalized_data.data());
+    return normalized_data;
+}
+
+template <typename T, typename Alloc>
+std::pmr::vector<scaled_t<T>> max_abs_normalisation(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<scaled_t<T>> normalized_data(data.size(), resource);
+    max_abs_normalisation(data.data(), data.size(), normalized_data.data());
+    return normalized_data;
+}
+
+template <typename T, typename Alloc>
+std::vector<scaled_t<T>> mean_normalisation(const std::vector<T, Alloc> &data)
+{
+    std::vector<scaled_t<T>> normalized_data(data.size());
+    mean_normalisation(data.data(), data.size(), normalized_data.data());
+    return normalized_data;
+}
+
+template <typename T, typename Alloc>
+std::pmr::vector<scaled_t<T>> mean_normalisation(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<scaled_t<T>> normalized_data(data.size(), resource);
+    mean_normalisation(data.data(), data.size(), normalized_data.data());
+    return normalized_data;
+}
@@ -0,0 +1,804 @@
+#pragma once
+
+// Principal component analysis for wide row-major inputs (e.g. 784-pixel
+// images), fitted with a randomized SVD
+
+#include "include_file.h"
+#include "Metrics.h"
+#include "Parallel.h"
+#include "Serialization.h"
+
+// Register-tiled products on row-major matrices. The A operand is given as
+// row pointers, so contiguous matrices, row vectors and mapped files share
+// one kernel, and its entries are converted as they are loaded (uint8
+// pixels are never copied to floating point). B has a leading dimension
+// that is a multiple of dense_tile<C>, zero padded, so a tile never needs a
+// column tail. Steps where every A entry of the tile is zero are skipped,
+// which pays off on sparse inputs (MNIST digits are ~80% zero pixels).
+template <typename C>
+constexpr size_t dense_tile = 128 / sizeof(C); // 4 x 4 AVX2 accumulators per tile
+
+template <typename C>
+size_t dense_stride(size_t cols)
+{
+    return (cols + dense_tile<C> - 1) / dense_tile<C> * dense_tile<C>;
+}
+
+// c (count x cols, row stride ldc) = A (count x inner) * b (inner x cols)
+template <typename C, typename A>
+void dense_multiply(const A *const *rows, size_t count, size_t inner, const C *b, size_t ldb, size_t cols, C *c, size_t ldc)
+{
+    constexpr size_t width = dense_tile<C>;
+    constexpr size_t height = 4;
+    for (size_t i = 0; i < count; i += height)
+    {
+        const size_t valid = std::min(height, count - i);
+        const A *a[height];
+        for (size_t r = 0; r < height; ++r)
+        {
+            a[r] = rows[i + std::min(r, valid - 1)]; // short tail: repeat the last row, results dropped
+        }
+        for (size_t j = 0; j < cols; j += width)
+        {
+            C acc0[width] = {}, acc1[width] = {}, acc2[width] = {}, acc3[width] = {};
+            for (size_t p = 0; p < inner; ++p)
+            {
+                const C x0 = static_cast<C>(a[0][p]);
+                const C x1 = static_cast<C>(a[1][p]);
+                const C x2 = static_cast<C>(a[2][p]);
+                const C x3 = static_cast<C>(a[3][p]);
+                if (x0 == C(0) && x1 == C(0) && x2 == C(0) && x3 == C(0))
+                {
+                    continue;
+                }
+                const C *bp = b + p * ldb + j;
+                for (size_t w = 0; w < width; ++w)
+                {
+                    acc0[w] += x0 * bp[w];
+                    acc1[w] += x1 * bp[w];
+                    acc2[w] += x2 * bp[w];
+                    acc3[w] += x3 * bp[w];
+                }
+            }
+            const size_t columns = std::min(width, cols - j);
+            const C *acc[height] = {acc0, acc1, acc2, acc3};
+            for (size_t r = 0; r < valid; ++r)
+            {
+                std::copy(acc[r], acc[r] + columns, c + (i + r) * ldc + j);
+            }
+        }
+    }
+}
+
+// z (inner x ld) += A^T (inner x count) * y (count x ld); ld is a multiple of dense_tile<C>
+template <typename C, typename A>
+void dense_transposed_multiply_add(const A *const *rows, size_t count, size_t inner, const C *y, size_t ld, C *z)
+{
+    constexpr size_t width = dense_tile<C>;
+    constexpr size_t height = 4;
+    size_t p = 0;
+    for (; p + height <= inner; p += height)
+    {
+        for (size_t j = 0; j < ld; j += width)
+        {
+            C acc0[width] = {}, acc1[width] = {}, acc2[width] = {}, acc3[width] = {};
+            for (size_t i = 0; i < count; ++i)
+            {
+                const A *a = rows[i] + p;
+                const C x0 = static_cast<C>(a[0]);
+                const C x1 = static_cast<C>(a[1]);
+                const C x2 = static_cast<C>(a[2]);
+                const C x3 = static_cast<C>(a[3]);
+                if (x0 == C(0) && x1 == C(0) && x2 == C(0) && x3 == C(0))
+                {
+                    continue;
+                }
+                const C *yi = y + i * ld + j;
+                for (size_t w = 0; w < width; ++w)
+                {
+                    acc0[w] += x0 * yi[w];
+                    acc1[w] += x1 * yi[w];
+                    acc2[w] += x2 * yi[w];
+                    acc3[w] += x3 * yi[w];
+                }
+            }
+            C *zp = z + p * ld + j;
+            for (size_t w = 0; w < width; ++w)
+            {
+                zp[w] += acc0[w];
+                zp[ld + w] += acc1[w];
+                zp[2 * ld + w] += acc2[w];
+                zp[3 * ld + w] += acc3[w];
+            }
+        }
+    }
+    for (; p < inner; ++p)
+    {
+        C *zp = z + p * ld;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const C x = static_cast<C>(rows[i][p]);
+            if (x == C(0))
+            {
+                continue;
+            }
+            const C *yi = y + i * ld;
+            for (size_t j = 0; j < ld; ++j)
+            {
+                zp[j] += x * yi[j];
+            }
+        }
+    }
+}
+
+// Eigen-decomposition of a symmetric n x n row-major matrix by cyclic Jacobi
+// rotations; eigenvalues come back in descending order, eigenvector k in
+// column k of vectors
+inline std::vector<double> symmetric_eigen(std::vector<double> a, size_t n, std::vector<double> &vectors)
+{
+    std::vector<double> v(n * n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i * n + i] = 1.0;
+    }
+    double norm = 0.0;
+    for (double value : a)
+    {
+        norm += value * value;
+    }
+    for (size_t sweep = 0; sweep < 100; ++sweep)
+    {
+        double off = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = i + 1; j < n; ++j)
+            {
+                off += a[i * n + j] * a[i * n + j];
+            }
+        }
+        if (off <= 1e-30 * norm)
+        {
+            break;
+        }
+        for (size_t p = 0; p < n; ++p)
+        {
+            for (size_t q = p + 1; q < n; ++q)
+            {
+                const double apq = a[p * n + q];
+                if (apq == 0.0)
+                {
+                    continue;
+                }
+                const double theta = (a[q * n + q] - a[p * n + p]) / (2.0 * apq);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double cs = 1.0 / std::sqrt(t * t + 1.0);
+                const double sn = t * cs;
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const double akp = a[k * n + p];
+                    const double akq = a[k * n + q];
+                    a[k * n + p] = cs * akp - sn * akq;
+                    a[k * n + q] = sn * akp + cs * akq;
+                }
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const double apk = a[p * n + k];
+                    const double aqk = a[q * n + k];
+                    a[p * n + k] = cs * apk - sn * aqk;
+                    a[q * n + k] = sn * apk + cs * aqk;
+                }
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const double vkp = v[k * n + p];
+                    const double vkq = v[k * n + q];
+                    v[k * n + p] = cs * vkp - sn * vkq;
+                    v[k * n + q] = sn * vkp + cs * vkq;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&](size_t x, size_t y)
+              { return a[x * n + x] > a[y * n + y]; });
+    std::vector<double> values(n);
+    vectors.assign(n * n, 0.0);
+    for (size_t k = 0; k < n; ++k)
+    {
+        values[k] = a[order[k] * n + order[k]];
+        for (size_t i = 0; i < n; ++i)
+        {
+            vectors[i * n + k] = v[i * n + order[k]];
+        }
+    }
+    return values;
+}
+
+// PCA
+// fit:       randomized SVD (Halko, Martinsson & Tropp) of the centred data.
+//            A Gaussian sketch of k + oversampling directions goes through
+//            power_iterations rounds of Q <- orth(Ac^T Ac Q), then the
+//            sketch-sized eigenproblem of Q^T Ac^T Ac Q gives the
+//            components. Every round is one streaming pass over the rows in
+//            blocks of blockRows (Y = B Q, Z += B^T Y, both register-tiled
+//            GEMMs, per-thread Z merged at the end); centring is applied to
+//            the small products, so the input is only read, never copied,
+//            centred or converted. Total: power_iterations + 2 passes.
+// transform: y = (x - mean) P for the d x k projection P, optionally
+//            whitened (unit variance per component).
+// The input element type is independent of T: uint8 pixels can be fitted
+// and projected straight from a mapped idx file. Results are reproducible
+// for a given seed and thread count.
+template <typename T = float>
+class PCA
+{
+private:
+    static constexpr size_t blockRows = 128;
+
+    size_t numComponents;
+    bool whiten;
+    size_t powerIterations;
+    size_t oversampling;
+    uint64_t seed;
+    size_t numThreads;
+
+    size_t dims = 0;
+    size_t samples = 0;
+    std::vector<double> meanValues;
+    std::vector<double> explainedVariance; // per component
+    double totalVariance = 0.0;
+    std::vector<T> projection;     // dims x dense_stride<T>(numComponents), zero padded
+    std::vector<T> reconstruction; // numComponents x dense_stride<T>(dims), for inverseTransform
+    std::vector<T> projectedMean;  // mean^T projection
+    bool isFitted = false;
+
+    void checkFitted() const
+    {
+        if (!isFitted)
+        {
+            throw std::logic_error("PCA has not been fitted. Call fit method first.");
+        }
+    }
+
+    void checkInput(size_t n, size_t d) const
+    {
+        if (n == 0 || d == 0)
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        if (n < 2)
+        {
+            throw std::invalid_argument("PCA needs at least 2 samples");
+        }
+        if (numComponents > d || numComponents > n)
+        {
+            throw std::invalid_argument("Number of components exceeds the number of samples or features");
+        }
+    }
+
+    // Gram-Schmidt with re-orthogonalisation on the columns of q (d x cols,
+    // row stride ld); a column that vanishes (data of lower rank than the
+    // sketch) is replaced by a fresh random direction
+    static void orthonormalize(std::vector<double> &q, size_t d, size_t cols, size_t ld, std::mt19937_64 &rng)
+    {
+        std::normal_distribution<double> gaussian;
+        for (size_t j = 0; j < cols; ++j)
+        {
+            for (size_t attempt = 0;; ++attempt)
+            {
+                double before = 0.0;
+                for (size_t p = 0; p < d; ++p)
+                {
+                    before += q[p * ld + j] * q[p * ld + j];
+                }
+                for (size_t pass = 0; pass < 2; ++pass)
+                {
+                    for (size_t i = 0; i < j; ++i)
+                    {
+                        double dot = 0.0;
+                        for (size_t p = 0; p < d; ++p)
+                        {
+                            dot += q[p * ld + i] * q[p * ld + j];
+                        }
+                        for (size_t p = 0; p < d; ++p)
+                        {
+                            q[p * ld + j] -= dot * q[p * ld + i];
+                        }
+                    }
+                }
+                double after = 0.0;
+                for (size_t p = 0; p < d; ++p)
+                {
+                    after += q[p * ld + j] * q[p * ld + j];
+                }
+                if (after > 1e-20 * before && after > 0.0)
+                {
+                    const double scale = 1.0 / std::sqrt(after);
+                    for (size_t p = 0; p < d; ++p)
+                    {
+                        q[p * ld + j] *= scale;
+                    }
+                    break;
+                }
+                if (attempt == 8)
+                {
+                    throw std::runtime_error("PCA: could not complete an orthonormal basis");
+                }
+                for (size_t p = 0; p < d; ++p)
+                {
+                    q[p * ld + j] = gaussian(rng);
+                }
+            }
+        }
+    }
+
+    // One pass: product = Ac^T Ac basis, with Ac the centred rows
+    template <typename A, typename RowAt>
+    void multiplyCovariance(RowAt row, size_t n, const std::vector<double> &basis, size_t ld, std::vector<double> &product) const
+    {
+        std::vector<double> meanBasis(ld, 0.0); // mean^T basis
+        for (size_t p = 0; p < dims; ++p)
+        {
+            for (size_t j = 0; j < ld; ++j)
+            {
+                meanBasis[j] += meanValues[p] * basis[p * ld + j];
+            }
+        }
+
+        const size_t workers = parallel_workers(n, numThreads, blockRows);
+        std::vector<std::vector<double>> partial(workers);
+        std::vector<std::vector<double>> columnSums(workers);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                std::vector<double> &z = partial[worker];
+                std::vector<double> &sums = columnSums[worker];
+                z.assign(dims * ld, 0.0);
+                sums.assign(ld, 0.0);
+                const A *rows[blockRows];
+                std::vector<double> y(blockRows * ld);
+                for (size_t first = begin; first < end; first += blockRows)
+                {
+                    const size_t count = std::min(blockRows, end - first);
+                    for (size_t r = 0; r < count; ++r)
+                    {
+                        rows[r] = row(first + r);
+                    }
+                    // Yc = B basis - 1 mean^T basis = Ac basis
+                    dense_multiply(rows, count, dims, basis.data(), ld, ld, y.data(), ld);
+                    for (size_t r = 0; r < count; ++r)
+                    {
+                        for (size_t j = 0; j < ld; ++j)
+                        {
+                            y[r * ld + j] -= meanBasis[j];
+                            sums[j] += y[r * ld + j];
+                        }
+                    }
+                    dense_transposed_multiply_add(rows, count, dims, y.data(), ld, z.data());
+                }
+            },
+            numThreads, blockRows);
+
+        // Ac^T Yc = B^T Yc - mean (1^T Yc)
+        product.assign(dims * ld, 0.0);
+        for (size_t w = 0; w < workers; ++w)
+        {
+            for (size_t p = 0; p < dims; ++p)
+            {
+                for (size_t j = 0; j < ld; ++j)
+                {
+                    product[p * ld + j] += partial[w][p * ld + j] - meanValues[p] * columnSums[w][j];
+                }
+            }
+        }
+    }
+
+    template <typename A, typename RowAt>
+    void fitRows(RowAt row, size_t n, size_t d)
+    {
+        checkInput(n, d);
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("pca.fit");
+        const ScopedOperation timing(metrics, n, n * d * sizeof(A));
+        dims = d;
+        samples = n;
+
+        // Column means and total variance, shifted by the first row so the
+        // sums of squares do not cancel
+        const size_t workers = parallel_workers(n, numThreads, blockRows);
+        std::vector<double> sums(workers * d, 0.0), squares(workers * d, 0.0);
+        const A *origin = row(0);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t worker)
+            {
+                double *sum = &sums[worker * d];
+                double *square = &squares[worker * d];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const A *x = row(i);
+                    for (size_t p = 0; p < d; ++p)
+                    {
+                        const double shifted = static_cast<double>(x[p]) - static_cast<double>(origin[p]);
+                        sum[p] += shifted;
+                        square[p] += shifted * shifted;
+                    }
+                }
+            },
+            numThreads, blockRows);
+        meanValues.assign(d, 0.0);
+        totalVariance = 0.0;
+        for (size_t p = 0; p < d; ++p)
+        {
+            double sum = 0.0, square = 0.0;
+            for (size_t w = 0; w < workers; ++w)
+            {
+                sum += sums[w * d + p];
+                square += squares[w * d + p];
+            }
+            meanValues[p] = static_cast<double>(origin[p]) + sum / static_cast<double>(n);
+            totalVariance += std::max(0.0, square - sum * sum / static_cast<double>(n));
+        }
+        totalVariance /= static_cast<double>(n - 1);
+
+        // Randomized subspace iteration on Ac^T Ac
+        const size_t sketch = std::min(d, numComponents + oversampling);
+        const size_t ld = dense_stride<double>(sketch);
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> gaussian;
+        std::vector<double> basis(d * ld, 0.0), product;
+        for (size_t p = 0; p < d; ++p)
+        {
+            for (size_t j = 0; j < sketch; ++j)
+            {
+                basis[p * ld + j] = gaussian(rng);
+            }
+        }
+        orthonormalize(basis, d, sketch, ld, rng);
+        for (size_t iteration = 0;; ++iteration)
+        {
+            multiplyCovariance<A>(row, n, basis, ld, product);
+            if (iteration == powerIterations)
+            {
+                break;
+            }
+            basis.swap(product);
+            orthonormalize(basis, d, sketch, ld, rng);
+        }
+
+        // Rayleigh-Ritz: eigenvectors of basis^T Ac^T Ac basis rotate the
+        // basis onto the principal directions
+        std::vector<double> small(sketch * sketch, 0.0);
+        for (size_t p = 0; p < d; ++p)
+        {
+            for (size_t i = 0; i < sketch; ++i)
+            {
+                for (size_t j = 0; j < sketch; ++j)
+                {
+                    small[i * sketch + j] += basis[p * ld + i] * product[p * ld + j];
+                }
+            }
+        }
+        for (size_t i = 0; i < sketch; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                const double symmetric = 0.5 * (small[i * sketch + j] + small[j * sketch + i]);
+                small[i * sketch + j] = small[j * sketch + i] = symmetric;
+            }
+        }
+        std::vector<double> rotation;
+        const std::vector<double> eigenvalues = symmetric_eigen(small, sketch, rotation);
+
+        std::vector<double> directions(d * numComponents, 0.0);
+        explainedVariance.assign(numComponents, 0.0);
+        for (size_t c = 0; c < numComponents; ++c)
+        {
+            explainedVariance[c] = std::max(0.0, eigenvalues[c]) / static_cast<double>(n - 1);
+            size_t largest = 0;
+            for (size_t p = 0; p < d; ++p)
+            {
+                double value = 0.0;
+                for (size_t j = 0; j < sketch; ++j)
+                {
+                    value += basis[p * ld + j] * rotation[j * sketch + c];
+                }
+                directions[p * numComponents + c] = value;
+                if (std::abs(value) > std::abs(directions[largest * numComponents + c]))
+                {
+                    largest = p;
+                }
+            }
+            // deterministic signs: the largest loading of each component is positive
+            if (directions[largest * numComponents + c] < 0.0)
+            {
+                for (size_t p = 0; p < d; ++p)
+                {
+                    directions[p * numComponents + c] = -directions[p * numComponents + c];
+                }
+            }
+        }
+        setProjection(directions);
+        isFitted = true;
+    }
+
+    // projection, reconstruction and projectedMean from the unit-length
+    // directions (dims x numComponents) and the explained variances
+    void setProjection(const std::vector<double> &directions)
+    {
+        const size_t ldp = dense_stride<T>(numComponents);
+        const size_t ldr = dense_stride<T>(dims);
+        projection.assign(dims * ldp, T(0));
+        reconstruction.assign(numComponents * ldr, T(0));
+        projectedMean.assign(numComponents, T(0));
+        for (size_t c = 0; c < numComponents; ++c)
+        {
+            const double deviation = std::sqrt(explainedVariance[c]);
+            const double scale = whiten && deviation > 0.0 ? 1.0 / deviation : 1.0;
+            double mean = 0.0;
+            for (size_t p = 0; p < dims; ++p)
+            {
+                const double direction = directions[p * numComponents + c];
+                projection[p * ldp + c] = static_cast<T>(direction * scale);
+                reconstruction[c * ldr + p] = static_cast<T>(whiten ? direction * deviation : direction);
+                mean += meanValues[p] * static_cast<double>(projection[p * ldp + c]);
+            }
+            projectedMean[c] = static_cast<T>(mean);
+        }
+    }
+
+    template <typename A, typename RowAt>
+    void transformRows(RowAt row, size_t n, T *out) const
+    {
+        checkFitted();
+        static OperationMetrics &metrics = MetricsRegistry::global().operation("pca.transform");
+        const ScopedOperation timing(metrics, n, n * dims * sizeof(A));
+        const size_t ldp = dense_stride<T>(numComponents);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t)
+            {
+                const A *rows[blockRows];
+                for (size_t first = begin; first < end; first += blockRows)
+                {
+                    const size_t count = std::min(blockRows, end - first);
+                    for (size_t r = 0; r < count; ++r)
+                    {
+                        rows[r] = row(first + r);
+                    }
+                    T *codes = out + first * numComponents;
+                    dense_multiply(rows, count, dims, projection.data(), ldp, numComponents, codes, numComponents);
+                    for (size_t r = 0; r < count; ++r)
+                    {
+                        for (size_t c = 0; c < numComponents; ++c)
+                        {
+                            codes[r * numComponents + c] -= projectedMean[c];
+                        }
+                    }
+                }
+            },
+            numThreads, blockRows);
+    }
+
+public:
+    /// @param num_components k, the number of components kept
+    /// @param whiten_components scale every component to unit variance
+    /// @param power_iterations subspace iterations; more sharpens slowly decaying spectra
+    /// @param over_sampling extra sketch directions beyond k
+    /// @param num_threads 0 = one per hardware thread
+    PCA(size_t num_components, bool whiten_components = false, size_t power_iterations = 4, size_t over_sampling = 10,
+        uint64_t random_seed = 0, size_t num_threads = 0)
+        : numComponents(num_components), whiten(whiten_components), powerIterations(power_iterations),
+          oversampling(over_sampling), seed(random_seed), numThreads(num_threads)
+    {
+        if (numComponents < 1)
+        {
+            throw std::invalid_argument("Number of components must be at least 1");
+        }
+    }
+
+    // data: n rows of d values, row-major and contiguous, of any arithmetic type
+    template <typename A>
+    void fit(const A *data, size_t n, size_t d)
+    {
+        fitRows<A>([data, d](size_t i)
+                   { return data + i * d; },
+                   n, d);
+    }
+
+    template <typename A>
+    void fit(const std::vector<std::vector<A>> &rows)
+    {
+        if (rows.empty())
+        {
+            throw std::invalid_argument("Input data is empty");
+        }
+        for (const auto &row : rows)
+        {
+            if (row.size() != rows[0].size())
+            {
+                throw std::invalid_argument("Inconsistent number of features in input data");
+            }
+        }
+        fitRows<A>([&rows](size_t i)
+                   { return rows[i].data(); },
+                   rows.size(), rows[0].size());
+    }
+
+    // out: n x k codes, row-major
+    template <typename A>
+    void transform(const A *data, size_t n, T *out) const
+    {
+        const size_t d = dims;
+        transformRows<A>([data, d](size_t i)
+                         { return data + i * d; },
+                         n, out);
+    }
+
+    template <typename A>
+    std::vector<std::vector<T>> transform(const std::vector<std::vector<A>> &rows) const
+    {
+        checkFitted();
+        for (const auto &row : rows)
+        {
+            if (row.size() != dims)
+            {
+                throw std::invalid_argument("Number of features does not match the fitted data");
+            }
+        }
+        std::vector<T> codes(rows.size() * numComponents);
+        transformRows<A>([&rows](size_t i)
+                         { return rows[i].data(); },
+                         rows.size(), codes.data());
+        std::vector<std::vector<T>> result(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            result[i].assign(codes.begin() + i * numComponents, codes.begin() + (i + 1) * numComponents);
+        }
+        return result;
+    }
+
+    // out: n x d approximations mean + codes P^T (undoing the whitening)
+    void inverseTransform(const T *codes, size_t n, T *out) const
+    {
+        checkFitted();
+        const size_t ldr = dense_stride<T>(dims);
+        parallel_for(
+            n,
+            [&](size_t begin, size_t end, size_t)
+            {
+                const T *rows[blockRows];
+                for (size_t first = begin; first < end; first += blockRows)
+                {
+                    const size_t count = std::min(blockRows, end - first);
+                    for (size_t r = 0; r < count; ++r)
+                    {
+                        rows[r] = codes + (first + r) * numComponents;
+                    }
+                    T *x = out + first * dims;
+                    dense_multiply(rows, count, numComponents, reconstruction.data(), ldr, dims, x, dims);
+                    for (size_t r = 0; r < count; ++r)
+                    {
+                        for (size_t p = 0; p < dims; ++p)
+                        {
+                            x[r * dims + p] += static_cast<T>(meanValues[p]);
+                        }
+                    }
+                }
+            },
+            numThreads, blockRows);
+    }
+
+    // Folds the projection into a dense layer that consumes the codes.
+    // weights: (k + 1) x outputs, input-major with the bias in the last row
+    // (the layout of OpenCV's ANN_MLP layers). Returns the (d + 1) x outputs
+    // layer that gives the same pre-activations on raw inputs: P W and
+    // b - projectedMean^T W.
+    std::vector<T> foldLinearLayer(const T *weights, size_t outputs) const
+    {
+        checkFitted();
+        const size_t ldw = dense_stride<T>(outputs);
+        std::vector<T> padded(numComponents * ldw, T(0));
+        for (size_t c = 0; c < numComponents; ++c)
+        {
+            std::copy(weights + c * outputs, weights + (c + 1) * outputs, padded.begin() + c * ldw);
+        }
+        const size_t ldp = dense_stride<T>(numComponents);
+        std::vector<const T *> rows(dims);
+        for (size_t p = 0; p < dims; ++p)
+        {
+            rows[p] = projection.data() + p * ldp;
+        }
+        std::vector<T> folded((dims + 1) * outputs);
+        dense_multiply(rows.data(), dims, numComponents, padded.data(), ldw, outputs, folded.data(), outputs);
+        for (size_t o = 0; o < outputs; ++o)
+        {
+            double bias = weights[numComponents * outputs + o];
+            for (size_t c = 0; c < numComponents; ++c)
+            {
+                bias -= static_cast<double>(projectedMean[c]) * weights[c * outputs + o];
+            }
+            folded[dims * outputs + o] = static_cast<T>(bias);
+        }
+        return folded;
+    }
+
+    // Components as rows (k x d), unit length (before whitening)
+    std::vector<T> getComponents() const
+    {
+        checkFitted();
+        const size_t ldr = dense_stride<T>(dims);
+        std::vector<T> components(numComponents * dims);
+        for (size_t c = 0; c < numComponents; ++c)
+        {
+            const double deviation = std::sqrt(explainedVariance[c]);
+            for (size_t p = 0; p < dims; ++p)
+            {
+                const double value = reconstruction[c * ldr + p];
+                components[c * dims + p] = static_cast<T>(whiten && deviation > 0.0 ? value / deviation : value);
+            }
+        }
+        return components;
+    }
+
+    std::vector<double> getExplainedVarianceRatio() const
+    {
+        checkFitted();
+        std::vector<double> ratio(numComponents);
+        for (size_t c = 0; c < numComponents; ++c)
+        {
+            ratio[c] = totalVariance > 0.0 ? explainedVariance[c] / totalVariance : 0.0;
+        }
+        return ratio;
+    }
+
+    const std::vector<double> &getExplainedVariance() const { return explainedVariance; }
+    const std::vector<double> &getMean() const { return meanValues; }
+    size_t getNumComponents() const { return numComponents; }
+    size_t getDimensions() const { return dims; }
+
+    void save(BinaryWriter &writer) const
+    {
+        checkFitted();
+        writer.writeHeader(SerialKind::PCA, serial_type<T>());
+        writer.write<uint64_t>(numComponents);
+        writer.write<uint64_t>(dims);
+        writer.write<uint64_t>(samples);
+        writer.write<uint8_t>(whiten);
+        writer.write<double>(totalVariance);
+        writer.writeArray(meanValues);
+        writer.writeArray(explainedVariance);
+        writer.writeArray(getComponents());
+    }
+
+    static PCA load(BinaryReader &reader)
+    {
+        reader.readHeader(SerialKind::PCA, serial_type<T>());
+        const size_t components = static_cast<size_t>(reader.read<uint64_t>());
+        PCA pca(std::max<size_t>(1, components));
+        pca.dims = static_cast<size_t>(reader.read<uint64_t>());
+        pca.samples = static_cast<size_t>(reader.read<uint64_t>());
+        pca.whiten = reader.read<uint8_t>() != 0;
+        pca.totalVariance = reader.read<double>();
+        pca.meanValues = reader.readVector<double>();
+        pca.explainedVariance = reader.readVector<double>();
+        const std::vector<T> rows = reader.readVector<T>();
+        if (components == 0 || pca.meanValues.size() != pca.dims || pca.explainedVariance.size() != components ||
+            rows.size() != components * pca.dims)
+        {
+            throw std::runtime_error("Serialized PCA is inconsistent");
+        }
+        std::vector<double> directions(pca.dims * components);
+        for (size_t c = 0; c < components; ++c)
+        {
+            for (size_t p = 0; p < pca.dims; ++p)
+            {
+                directions[p * components + c] = rows[c * pca.dims + p];
+            }
+        }
+        pca.setProjection(directions);
+        pca.isFitted = true;
+        return pca;
+    }
+};
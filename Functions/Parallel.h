@@ -0,0 +1,94 @@
+#pragma once
+
+#include "include_file.h"
+
+// Minimal fork-join helpers shared by the Functions/ classes.
+// Work is split into contiguous ranges, one per worker, so callers can keep
+// per-worker state (histograms, sketches, partial sums) and merge it afterwards.
+
+inline size_t default_thread_count()
+{
+    const unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Number of workers parallel_for will use for n items; callers size their
+// per-worker state with this before calling parallel_for
+inline size_t parallel_workers(size_t n, size_t num_threads = 0, size_t min_chunk = 4096)
+{
+    if (num_threads == 0)
+    {
+        num_threads = default_thread_count();
+    }
+    const size_t by_size = std::max<size_t>(1, n / std::max<size_t>(1, min_chunk));
+    return std::max<size_t>(1, std::min(num_threads, by_size));
+}
+
+// Runs fn(begin, end, worker) over [0, n) split into parallel_workers(...) ranges.
+// The calling thread processes the first range itself. An exception thrown by
+// any range is rethrown here once every worker has joined; when several throw,
+// the one from the lowest range wins, so errors surface in input order.
+template <typename Fn>
+void parallel_for(size_t n, Fn &&fn, size_t num_threads = 0, size_t min_chunk = 4096)
+{
+    const size_t workers = parallel_workers(n, num_threads, min_chunk);
+    if (workers == 1)
+    {
+        fn(size_t(0), n, size_t(0));
+        return;
+    }
+
+    const size_t step = n / workers;
+    const size_t remainder = n % workers;
+
+    std::vector<std::exception_ptr> errors(workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+
+    size_t begin = step + (remainder > 0 ? 1 : 0);
+    for (size_t w = 1; w < workers; ++w)
+    {
+        const size_t end = begin + step + (w < remainder ? 1 : 0);
+        try
+        {
+            threads.emplace_back([&fn, &errors, begin, end, w]()
+                                 {
+                                     try
+                                     {
+                                         fn(begin, end, w);
+                                     }
+                                     catch (...)
+                                     {
+                                         errors[w] = std::current_exception();
+                                     } });
+        }
+        catch (...)
+        {
+            // thread creation failed: join the started workers, then rethrow
+            errors[w] = std::current_exception();
+            break;
+        }
+        begin = end;
+    }
+
+    try
+    {
+        fn(size_t(0), step + (remainder > 0 ? 1 : 0), size_t(0));
+    }
+    catch (...)
+    {
+        errors[0] = std::current_exception();
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    for (const std::exception_ptr &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
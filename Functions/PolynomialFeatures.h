@@ -0,0 +1,151 @@
+#pragma once
+
+#include "include_file.h"
+#include "Parallel.h"
+
+// Polynomial / interaction expansion of a row-major matrix (like sklearn's
+// PolynomialFeatures, same output column order).
+//
+// Output columns per row: [1 if includeBias] [x_0 .. x_{n-1}] [degree-2
+// monomials] ... [degree-d monomials], each degree in lexicographic order of
+// the feature indices (x0*x0, x0*x1, .., x1*x1, ..). With interactionOnly no
+// feature appears twice in a monomial (x0*x1 but not x0*x0).
+//
+// No std::pow: every degree-k monomial is one multiplication of a degree-(k-1)
+// monomial already written to the same output row. The degree-k terms whose
+// lowest feature is j are x_j times the contiguous run of degree-(k-1) terms
+// whose lowest feature is >= j (> j for interactionOnly), so each run is a
+// contiguous scaled copy within the row. The run table depends only on the
+// number of input features and is built once in fit.
+template <typename T>
+class PolynomialFeatures
+{
+private:
+    struct Run
+    {
+        size_t feature; // multiplier x_feature
+        size_t source;  // first output column of the degree-(k-1) run
+        size_t length;
+        size_t target; // first output column written
+    };
+
+    size_t degree;
+    bool interactionOnly;
+    bool includeBias;
+    size_t numInputFeatures = 0;
+    size_t numOutputFeatures = 0;
+    std::vector<Run> runs; // in output column order
+
+    void expandRow(const T *x, T *out) const
+    {
+        size_t column = 0;
+        if (includeBias)
+        {
+            out[column++] = T(1);
+        }
+        std::copy(x, x + numInputFeatures, out + column);
+        for (const Run &run : runs)
+        {
+            const T factor = x[run.feature];
+            const T *source = out + run.source;
+            T *target = out + run.target;
+            for (size_t t = 0; t < run.length; ++t)
+            {
+                target[t] = source[t] * factor;
+            }
+        }
+    }
+
+public:
+    explicit PolynomialFeatures(size_t max_degree = 2, bool interaction_only = false, bool include_bias = false)
+        : degree(max_degree), interactionOnly(interaction_only), includeBias(include_bias)
+    {
+        if (degree == 0)
+        {
+            throw std::invalid_argument("Degree must be at least 1");
+        }
+    }
+
+    void fit(size_t num_input_features)
+    {
+        if (num_input_features == 0)
+        {
+            throw std::invalid_argument("At least one input feature is required");
+        }
+        numInputFeatures = num_input_features;
+        runs.clear();
+
+        // start[j]: first column of the previous degree's terms with lowest feature j; start[n]: its end
+        const size_t base = includeBias ? 1 : 0;
+        std::vector<size_t> start(numInputFeatures + 1);
+        std::iota(start.begin(), start.end(), base);
+        size_t column = base + numInputFeatures;
+
+        for (size_t k = 2; k <= degree; ++k)
+        {
+            std::vector<size_t> next(numInputFeatures + 1);
+            for (size_t j = 0; j < numInputFeatures; ++j)
+            {
+                const size_t first = interactionOnly ? start[j + 1] : start[j];
+                const size_t length = start[numInputFeatures] - first;
+                next[j] = column;
+                if (length > 0)
+                {
+                    if (column > std::numeric_limits<size_t>::max() - length)
+                    {
+                        throw std::length_error("Too many polynomial features");
+                    }
+                    runs.push_back(Run{j, first, length, column});
+                    column += length;
+                }
+            }
+            next[numInputFeatures] = column;
+            if (next[0] == column)
+            {
+                break; // interactionOnly and degree > number of features
+            }
+            start.swap(next);
+        }
+        numOutputFeatures = column;
+    }
+
+    size_t getNumInputFeatures() const
+    {
+        return numInputFeatures;
+    }
+
+    size_t getNumOutputFeatures() const
+    {
+        return numOutputFeatures;
+    }
+
+    // input: rows x getNumInputFeatures(), output: rows x getNumOutputFeatures(),
+    // both row-major; callers can stream large tables through in row blocks
+    void transform(const T *input, size_t rows, T *output, size_t num_threads = 0) const
+    {
+        if (numOutputFeatures == 0)
+        {
+            throw std::logic_error("PolynomialFeatures must be fitted before transform");
+        }
+        parallel_for(
+            rows, [&](size_t begin, size_t end, size_t)
+            {
+                for (size_t r = begin; r < end; ++r)
+                {
+                    expandRow(input + r * numInputFeatures, output + r * numOutputFeatures);
+                } },
+            num_threads, 64);
+    }
+
+    std::vector<T> transform(const std::vector<T> &input, size_t num_threads = 0) const
+    {
+        if (numInputFeatures == 0 || input.size() % numInputFeatures != 0)
+        {
+            throw std::invalid_argument("Input size is not a multiple of the number of features");
+        }
+        const size_t rows = input.size() / numInputFeatures;
+        std::vector<T> output(rows * numOutputFeatures);
+        transform(input.data(), rows, output.data(), num_threads);
+        return output;
+    }
+};
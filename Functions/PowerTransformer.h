@@ -0,0 +1,426 @@
+#pragma once
+
+#include "include_file.h"
+#include "Parallel.h"
+#include "VectorMath.h"
+
+// Box-Cox / Yeo-Johnson power transform with maximum-likelihood lambda
+// (the objective of scipy.stats.boxcox / yeojohnson and sklearn's
+// PowerTransformer, without the standardisation step).
+//
+// Fitting reads each column once: it takes the log terms (log x for
+// Box-Cox, log(1 + |x|) for Yeo-Johnson) with vector_log and keeps them,
+// together with their sum for the Jacobian term. Every later likelihood
+// evaluation is then one vector_exp pass over the cached logs:
+//   Box-Cox:     llf = (lambda - 1) sum log x - n/2 log var(y), where
+//                var(y) = exp(2 lambda c) var(exp(lambda (log x - c)) - 1) / lambda^2
+//                with c = mean log x, so large |lambda| does not overflow
+//   Yeo-Johnson: llf = (lambda - 1) sum sign(x) log(1 + |x|) - n/2 log var(psi)
+// Variances are combined per block of values (Chan et al.), so they are
+// stable in a single pass. The candidate grid over [-5, 5] is evaluated in
+// parallel, one candidate per thread, and Brent's method then refines the
+// best bracket. NaNs are ignored by fit and passed through by transform;
+// sample_size > 0 fits on a deterministic strided sample.
+// fit and transform take float or double storage; the likelihood is always
+// evaluated in double, transform computes in the storage type.
+enum class PowerMethod
+{
+    BoxCox,
+    YeoJohnson,
+};
+
+class PowerTransformer
+{
+private:
+    static constexpr size_t block = 1024;
+    static constexpr double lambdaLow = -5.0;
+    static constexpr double lambdaHigh = 5.0;
+    static constexpr size_t gridSize = 21;
+    static constexpr double tiny = 1e-9;
+
+    PowerMethod method;
+    size_t sampleSize;
+    size_t numThreads;
+    std::vector<double> lambdas;
+
+    struct Moments
+    {
+        double count = 0.0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(const double *values, size_t n)
+        {
+            double blockMean = 0.0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                blockMean += values[i];
+            }
+            blockMean /= n;
+            double blockM2 = 0.0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                blockM2 += (values[i] - blockMean) * (values[i] - blockMean);
+            }
+            merge(Moments{static_cast<double>(n), blockMean, blockM2});
+        }
+
+        void merge(const Moments &other)
+        {
+            if (other.count == 0.0)
+            {
+                return;
+            }
+            const double total = count + other.count;
+            const double delta = other.mean - mean;
+            mean += delta * other.count / total;
+            m2 += other.m2 + delta * delta * count * other.count / total;
+            count = total;
+        }
+
+        double variance() const
+        {
+            return m2 / count;
+        }
+    };
+
+    // Cached per-column state: log terms plus the Jacobian sum
+    struct LogColumn
+    {
+        std::vector<double> logs;     // log x, or log(1 + |x|)
+        std::vector<uint8_t> negative; // Yeo-Johnson only
+        double jacobian = 0.0;        // sum log x, or sum sign(x) log(1 + |x|)
+        double center = 0.0;          // mean of logs
+    };
+
+    template <typename T>
+    LogColumn prepare(const T *column, size_t n) const
+    {
+        std::vector<double> values;
+        values.reserve(sampleSize > 0 ? std::min(n, sampleSize) : n);
+        const double stride = sampleSize > 0 && sampleSize < n ? static_cast<double>(n) / sampleSize : 1.0;
+        for (double position = 0.0; position < n; position += stride)
+        {
+            const double value = static_cast<double>(column[static_cast<size_t>(position)]);
+            if (std::isnan(value))
+            {
+                continue;
+            }
+            if (method == PowerMethod::BoxCox && !(value > 0.0))
+            {
+                throw std::invalid_argument("Box-Cox requires strictly positive data");
+            }
+            values.push_back(value);
+        }
+        if (values.size() < 2)
+        {
+            throw std::invalid_argument("At least two non-missing values are required to fit lambda");
+        }
+
+        LogColumn prepared;
+        if (method == PowerMethod::YeoJohnson)
+        {
+            prepared.negative.resize(values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                prepared.negative[i] = values[i] < 0.0;
+                values[i] = 1.0 + std::abs(values[i]);
+            }
+        }
+        prepared.logs.resize(values.size());
+        vector_log(values.data(), values.size(), prepared.logs.data());
+
+        for (size_t i = 0; i < prepared.logs.size(); ++i)
+        {
+            const double signedLog = method == PowerMethod::YeoJohnson && prepared.negative[i] ? -prepared.logs[i] : prepared.logs[i];
+            prepared.jacobian += signedLog;
+            prepared.center += prepared.logs[i];
+        }
+        prepared.center /= prepared.logs.size();
+        return prepared;
+    }
+
+    // Transformed values of logs[first, first + count) under lambda, written to out
+    void transformBlock(const LogColumn &column, size_t first, size_t count, double lambda, double *out) const
+    {
+        const double *logs = column.logs.data() + first;
+        if (method == PowerMethod::BoxCox)
+        {
+            // exp(lambda (log x - c)) - 1, i.e. shifted and rescaled x^lambda
+            if (std::abs(lambda) < tiny)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out[i] = logs[i] - column.center;
+                }
+                return;
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = lambda * (logs[i] - column.center);
+            }
+            vector_exp(out, count, out);
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] -= 1.0;
+            }
+            return;
+        }
+
+        const uint8_t *negative = column.negative.data() + first;
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = (negative[i] ? 2.0 - lambda : lambda) * logs[i];
+        }
+        vector_exp(out, count, out);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double power = negative[i] ? 2.0 - lambda : lambda;
+            const double magnitude = std::abs(power) < tiny ? logs[i] : (out[i] - 1.0) / power;
+            out[i] = negative[i] ? -magnitude : magnitude;
+        }
+    }
+
+    double logLikelihood(const LogColumn &column, double lambda, size_t threads) const
+    {
+        const size_t n = column.logs.size();
+        const size_t blocks = (n + block - 1) / block;
+        std::vector<Moments> partial(parallel_workers(blocks, threads, 16));
+        parallel_for(
+            blocks, [&](size_t begin, size_t end, size_t worker)
+            {
+                double buffer[block];
+                for (size_t b = begin; b < end; ++b)
+                {
+                    const size_t first = b * block;
+                    const size_t count = std::min(block, n - first);
+                    transformBlock(column, first, count, lambda, buffer);
+                    partial[worker].add(buffer, count);
+                } },
+            threads, 16);
+
+        Moments moments;
+        for (const Moments &part : partial)
+        {
+            moments.merge(part);
+        }
+        const double variance = moments.variance();
+        if (!(variance > 0.0) || !std::isfinite(variance))
+        {
+            return -std::numeric_limits<double>::infinity();
+        }
+
+        double logVariance = std::log(variance);
+        if (method == PowerMethod::BoxCox && std::abs(lambda) >= tiny)
+        {
+            logVariance += 2.0 * lambda * column.center - 2.0 * std::log(std::abs(lambda));
+        }
+        return (lambda - 1.0) * column.jacobian - 0.5 * static_cast<double>(n) * logVariance;
+    }
+
+    // Brent's method (parabolic steps with golden-section fallback) for the
+    // maximum of f on [a, b]
+    template <typename Fn>
+    static double brentMaximize(Fn &&f, double a, double b, double tolerance = 1e-8, int max_iterations = 100)
+    {
+        const double golden = 0.3819660112501051;
+        double x = a + golden * (b - a);
+        double w = x, v = x;
+        double fx = -f(x);
+        double fw = fx, fv = fx;
+        double d = 0.0, e = 0.0;
+
+        for (int iteration = 0; iteration < max_iterations; ++iteration)
+        {
+            const double middle = 0.5 * (a + b);
+            const double tol1 = tolerance * std::abs(x) + 1e-12;
+            const double tol2 = 2.0 * tol1;
+            if (std::abs(x - middle) <= tol2 - 0.5 * (b - a))
+            {
+                break;
+            }
+
+            bool parabolic = false;
+            if (std::abs(e) > tol1)
+            {
+                const double r = (x - w) * (fx - fv);
+                double q = (x - v) * (fx - fw);
+                double p = (x - v) * q - (x - w) * r;
+                q = 2.0 * (q - r);
+                if (q > 0.0)
+                {
+                    p = -p;
+                }
+                q = std::abs(q);
+                if (std::abs(p) < std::abs(0.5 * q * e) && p > q * (a - x) && p < q * (b - x))
+                {
+                    e = d;
+                    d = p / q;
+                    const double u = x + d;
+                    if (u - a < tol2 || b - u < tol2)
+                    {
+                        d = x < middle ? tol1 : -tol1;
+                    }
+                    parabolic = true;
+                }
+            }
+            if (!parabolic)
+            {
+                e = (x < middle ? b : a) - x;
+                d = golden * e;
+            }
+
+            const double u = std::abs(d) >= tol1 ? x + d : x + (d > 0.0 ? tol1 : -tol1);
+            const double fu = -f(u);
+            if (fu <= fx)
+            {
+                (u < x ? b : a) = x;
+                v = w, fv = fw;
+                w = x, fw = fx;
+                x = u, fx = fu;
+            }
+            else
+            {
+                (u < x ? a : b) = u;
+                if (fu <= fw || w == x)
+                {
+                    v = w, fv = fw;
+                    w = u, fw = fu;
+                }
+                else if (fu <= fv || v == x || v == w)
+                {
+                    v = u, fv = fu;
+                }
+            }
+        }
+        return x;
+    }
+
+public:
+    explicit PowerTransformer(PowerMethod power_method = PowerMethod::YeoJohnson, size_t sample_size = 0, size_t num_threads = 0)
+        : method(power_method), sampleSize(sample_size), numThreads(num_threads) {}
+
+    // Maximum-likelihood lambda of one column
+    template <typename T>
+    double fitLambda(const T *column, size_t n) const
+    {
+        const LogColumn prepared = prepare(column, n);
+
+        // coarse grid, one candidate per thread
+        const double step = (lambdaHigh - lambdaLow) / (gridSize - 1);
+        std::vector<double> scores(gridSize);
+        parallel_for(
+            gridSize, [&](size_t begin, size_t end, size_t)
+            {
+                for (size_t g = begin; g < end; ++g)
+                {
+                    scores[g] = logLikelihood(prepared, lambdaLow + g * step, 1);
+                } },
+            numThreads, 1);
+
+        const size_t best = static_cast<size_t>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+        const double low = lambdaLow + (best == 0 ? 0 : best - 1) * step;
+        const double high = lambdaLow + std::min(best + 1, gridSize - 1) * step;
+
+        // refine inside the bracket, each evaluation split over threads
+        return brentMaximize([&](double lambda)
+                             { return logLikelihood(prepared, lambda, numThreads); },
+                             low, high);
+    }
+
+    template <typename T>
+    double logLikelihood(const T *column, size_t n, double lambda) const
+    {
+        return logLikelihood(prepare(column, n), lambda, numThreads);
+    }
+
+    // features: rows x columns, one lambda per column
+    template <typename T>
+    void fit(const std::vector<std::vector<T>> &features)
+    {
+        if (features.empty())
+        {
+            throw std::invalid_argument("Cannot fit a PowerTransformer on empty data");
+        }
+        const size_t numFeatures = features[0].size();
+        lambdas.assign(numFeatures, 1.0);
+        std::vector<T> column(features.size());
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            for (size_t i = 0; i < features.size(); ++i)
+            {
+                column[i] = features[i][j];
+            }
+            lambdas[j] = fitLambda(column.data(), column.size());
+        }
+    }
+
+    // output[i] = transform of input[i] under lambda
+    template <typename T>
+    void transform(const T *input, size_t n, double lambda, T *output) const
+    {
+        if (method == PowerMethod::BoxCox)
+        {
+            vector_box_cox(input, n, static_cast<T>(lambda), output);
+            return;
+        }
+
+        const T positive = static_cast<T>(lambda);
+        const T negative = static_cast<T>(2.0 - lambda);
+        const bool positiveLog = std::abs(lambda) < tiny;
+        const bool negativeLog = std::abs(2.0 - lambda) < tiny;
+        for (size_t first = 0; first < n; first += block)
+        {
+            const size_t count = std::min(block, n - first);
+            const T *x = input + first;
+            T *y = output + first;
+            T logs[block];
+            for (size_t i = 0; i < count; ++i)
+            {
+                logs[i] = T(1) + std::abs(x[i]);
+            }
+            vector_log(logs, count, logs);
+            for (size_t i = 0; i < count; ++i)
+            {
+                y[i] = (x[i] < T(0) ? negative : positive) * logs[i];
+            }
+            vector_exp(y, count, y);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const bool below = x[i] < T(0);
+                const T magnitude = (below ? negativeLog : positiveLog) ? logs[i] : (y[i] - T(1)) / (below ? negative : positive);
+                y[i] = below ? -magnitude : magnitude;
+            }
+        }
+    }
+
+    template <typename T>
+    std::vector<std::vector<T>> transform(const std::vector<std::vector<T>> &features) const
+    {
+        if (lambdas.empty())
+        {
+            throw std::logic_error("PowerTransformer must be fitted before transform");
+        }
+        std::vector<std::vector<T>> transformed(features.size(), std::vector<T>(lambdas.size()));
+        std::vector<T> column(features.size());
+        std::vector<T> result(features.size());
+        for (size_t j = 0; j < lambdas.size(); ++j)
+        {
+            for (size_t i = 0; i < features.size(); ++i)
+            {
+                column[i] = features[i][j];
+            }
+            transform(column.data(), column.size(), lambdas[j], result.data());
+            for (size_t i = 0; i < features.size(); ++i)
+            {
+                transformed[i][j] = result[i];
+            }
+        }
+        return transformed;
+    }
+
+    const std::vector<double> &getLambdas() const
+    {
+        return lambdas;
+    }
+};
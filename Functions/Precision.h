@@ -0,0 +1,11 @@
+#pragma once
+
+#include "include_file.h"
+
+// Storage type of scaled / transformed values. float inputs stay float
+// (half the memory traffic, twice the SIMD lanes, and the layout of CV_32F
+// so the features feed the model without a conversion); every other input
+// type is scaled into double. Statistics (sums, means, variances, fitted
+// parameters) are accumulated in double whatever the storage type.
+template <typename T>
+using scaled_t = std::conditional_t<std::is_same_v<T, float>, float, double>;
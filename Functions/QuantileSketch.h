@@ -0,0 +1,301 @@
+#pragma once
+
+#include "include_file.h"
+
+// KLL quantile sketch (Karnin, Lang, Liberty 2016)
+//
+// Keeps a stack of compactors; level h holds items of weight 2^h. When the
+// sketch grows past its capacity the lowest full level is sorted and every
+// other item is promoted to the next level. Memory is O(k log(n/k)) and the
+// rank error is about normalizedRankError() with high probability.
+//
+// Sketches with the same k can be merged, so each thread / shard / file can
+// build its own sketch and the results combined at the end.
+// NaN values are ignored.
+template <typename T>
+class KllSketch
+{
+private:
+    static constexpr size_t min_level_capacity = 8;
+
+    size_t k;
+    uint64_t n = 0;
+    std::vector<std::vector<T>> compactors;
+    size_t num_retained = 0;
+    size_t total_capacity = 0;
+    T min_value = std::numeric_limits<T>::max();
+    T max_value = std::numeric_limits<T>::lowest();
+    uint64_t rng_state;
+
+    // sorted (value, cumulative weight) view used by quantile/rank queries
+    mutable std::vector<std::pair<T, uint64_t>> sorted_view;
+    mutable bool sorted_view_valid = false;
+
+    size_t levelCapacity(size_t level) const
+    {
+        const size_t depth = compactors.size() - level - 1;
+        const double capacity = std::ceil(static_cast<double>(k) * std::pow(2.0 / 3.0, static_cast<double>(depth)));
+        return std::max(min_level_capacity, static_cast<size_t>(capacity));
+    }
+
+    void updateTotalCapacity()
+    {
+        total_capacity = 0;
+        for (size_t level = 0; level < compactors.size(); ++level)
+        {
+            total_capacity += levelCapacity(level);
+        }
+    }
+
+    bool nextRandomBit()
+    {
+        // xorshift64, seeded per sketch so results are reproducible
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        return (rng_state >> 32) & 1;
+    }
+
+    void compactLevel(size_t level)
+    {
+        if (level + 1 == compactors.size())
+        {
+            compactors.emplace_back();
+            updateTotalCapacity();
+        }
+
+        std::vector<T> &items = compactors[level];
+        std::sort(items.begin(), items.end());
+
+        // an odd item stays behind at this level
+        const bool keep_last = items.size() % 2 == 1;
+        T leftover = keep_last ? items.back() : T();
+        const size_t paired = items.size() - (keep_last ? 1 : 0);
+
+        std::vector<T> &next = compactors[level + 1];
+        next.reserve(next.size() + paired / 2);
+        for (size_t i = nextRandomBit() ? 1 : 0; i < paired; i += 2)
+        {
+            next.push_back(items[i]);
+        }
+
+        items.clear();
+        if (keep_last)
+        {
+            items.push_back(leftover);
+        }
+        num_retained -= paired / 2;
+    }
+
+    void compress()
+    {
+        while (num_retained > total_capacity)
+        {
+            for (size_t level = 0; level < compactors.size(); ++level)
+            {
+                if (compactors[level].size() >= levelCapacity(level))
+                {
+                    compactLevel(level);
+                    break;
+                }
+            }
+        }
+    }
+
+    void buildSortedView() const
+    {
+        if (sorted_view_valid)
+        {
+            return;
+        }
+
+        sorted_view.clear();
+        sorted_view.reserve(num_retained);
+        for (size_t level = 0; level < compactors.size(); ++level)
+        {
+            const uint64_t weight = uint64_t(1) << level;
+            for (const T &value : compactors[level])
+            {
+                sorted_view.emplace_back(value, weight);
+            }
+        }
+        std::sort(sorted_view.begin(), sorted_view.end(),
+                  [](const auto &lhs, const auto &rhs)
+                  { return lhs.first < rhs.first; });
+
+        uint64_t cumulative = 0;
+        for (auto &entry : sorted_view)
+        {
+            cumulative += entry.second;
+            entry.second = cumulative;
+        }
+        sorted_view_valid = true;
+    }
+
+public:
+    explicit KllSketch(size_t k_param = 200, uint64_t seed = 0x9E3779B97F4A7C15ULL)
+        : k(k_param), compactors(1), rng_state(seed == 0 ? 1 : seed)
+    {
+        if (k < min_level_capacity)
+        {
+            throw std::invalid_argument("KLL parameter k must be at least 8");
+        }
+        updateTotalCapacity();
+    }
+
+    void update(T value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (std::isnan(value))
+            {
+                return;
+            }
+        }
+
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+        compactors[0].push_back(value);
+        ++num_retained;
+        ++n;
+        sorted_view_valid = false;
+
+        if (num_retained > total_capacity)
+        {
+            compress();
+        }
+    }
+
+    // Chunked ingestion: fills level 0 up to its capacity between compactions
+    void update(const T *values, size_t count)
+    {
+        size_t i = 0;
+        while (i < count)
+        {
+            const size_t room = total_capacity > num_retained ? total_capacity - num_retained + 1 : 1;
+            const size_t end = std::min(count, i + room);
+            for (; i < end; ++i)
+            {
+                const T value = values[i];
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    if (std::isnan(value))
+                    {
+                        continue;
+                    }
+                }
+                min_value = std::min(min_value, value);
+                max_value = std::max(max_value, value);
+                compactors[0].push_back(value);
+                ++num_retained;
+                ++n;
+            }
+            sorted_view_valid = false;
+            compress();
+        }
+    }
+
+    void update(const std::vector<T> &values)
+    {
+        update(values.data(), values.size());
+    }
+
+    void merge(const KllSketch &other)
+    {
+        if (other.k != k)
+        {
+            throw std::invalid_argument("Cannot merge KLL sketches with different k");
+        }
+        if (other.n == 0)
+        {
+            return;
+        }
+
+        while (compactors.size() < other.compactors.size())
+        {
+            compactors.emplace_back();
+        }
+        updateTotalCapacity();
+
+        for (size_t level = 0; level < other.compactors.size(); ++level)
+        {
+            compactors[level].insert(compactors[level].end(),
+                                     other.compactors[level].begin(), other.compactors[level].end());
+        }
+
+        num_retained += other.num_retained;
+        n += other.n;
+        min_value = std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+        sorted_view_valid = false;
+        compress();
+    }
+
+    // Builds the query view now, so later quantile / rank calls on the
+    // unchanged sketch only read and can run concurrently
+    void prepareQueries() const
+    {
+        buildSortedView();
+    }
+
+    // Approximate q-quantile, q in [0, 1]; q = 0 and q = 1 are exact (min / max)
+    T quantile(double q) const
+    {
+        if (n == 0)
+        {
+            throw std::logic_error("Quantile of an empty sketch");
+        }
+        if (q <= 0.0)
+        {
+            return min_value;
+        }
+        if (q >= 1.0)
+        {
+            return max_value;
+        }
+
+        buildSortedView();
+        const double target = q * static_cast<double>(n);
+        auto it = std::lower_bound(sorted_view.begin(), sorted_view.end(), target,
+                                   [](const auto &entry, double value)
+                                   { return static_cast<double>(entry.second) < value; });
+        if (it == sorted_view.end())
+        {
+            return max_value;
+        }
+        return it->first;
+    }
+
+    // Approximate fraction of the stream that is <= value
+    double rank(T value) const
+    {
+        if (n == 0)
+        {
+            return 0.0;
+        }
+
+        buildSortedView();
+        auto it = std::upper_bound(sorted_view.begin(), sorted_view.end(), value,
+                                   [](T v, const auto &entry)
+                                   { return v < entry.first; });
+        if (it == sorted_view.begin())
+        {
+            return 0.0;
+        }
+        return static_cast<double>((it - 1)->second) / static_cast<double>(n);
+    }
+
+    // Rank error bound (99% confidence) for a single quantile/rank query,
+    // empirical constants from the Apache DataSketches KLL implementation
+    double normalizedRankError() const
+    {
+        return 2.296 / std::pow(static_cast<double>(k), 0.9723);
+    }
+
+    uint64_t count() const { return n; }
+    size_t getK() const { return k; }
+    size_t retained() const { return num_retained; }
+    bool empty() const { return n == 0; }
+    T min() const { return min_value; }
+    T max() const { return max_value; }
+};
@@ -0,0 +1,357 @@
+#pragma once
+
+#include "include_file.h"
+#include "BinCut.h"
+#include "Parallel.h"
+#include "QuantileSketch.h"
+
+// Rank-based transform of each column to uniform [0, 1] or standard normal
+// (like sklearn's QuantileTransformer).
+//
+// fit keeps a table of num_quantiles quantiles per column, at the evenly
+// spaced references 0, 1/(m-1), .., 1, taken from a sort of the column
+// (linear interpolation, as np.percentile) or from a KllSketch for data that
+// does not fit in memory. transform is piecewise-linear interpolation of the
+// value against that table:
+//   - the interval is found with BinCutter (branch-free Eytzinger search,
+//     AVX2 gathers, or O(1) when the quantiles are evenly spaced),
+//   - each interval keeps its quantile, output value, output slope and tie
+//     value together, so the per-value work is one multiply-add, a clamp and
+//     a few selects on 32 contiguous bytes,
+//   - a value equal to a run of repeated quantiles maps to the middle of the
+//     run (sklearn averages the forward and backward interpolation).
+// Normal output interpolates a table of inverse-normal values taken at the
+// same references (clipped to [1e-7, 1 - 1e-7] like sklearn), so no erf
+// inverse is evaluated per value; it is exact at the table points and linear
+// in between. NaNs are ignored by fit and passed through by transform.
+// T is the storage type (float or double): quantiles are computed in double
+// and stored as T, and transform interpolates in T, so float columns keep a
+// 16-byte knot and 8-lane searches.
+enum class QuantileOutput
+{
+    Uniform,
+    Normal,
+};
+
+// Inverse of the standard normal CDF: Acklam's rational approximation
+// (relative error 1.15e-9) polished with one Halley step on erfc, which takes
+// it to double precision. Used to build lookup tables, not per value.
+inline double inverse_normal_cdf(double p)
+{
+    if (!(p > 0.0))
+    {
+        return p == 0.0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+    }
+    if (!(p < 1.0))
+    {
+        return p == 1.0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    static const double a[6] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[5] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[4] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                3.754408661907416e+00};
+    const double low = 0.02425;
+
+    double x;
+    if (p < low)
+    {
+        const double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    else if (p <= 1.0 - low)
+    {
+        const double q = p - 0.5;
+        const double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+    else
+    {
+        const double q = std::sqrt(-2.0 * std::log1p(-p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    const double u = e * 2.5066282746310002 * std::exp(0.5 * x * x); // sqrt(2 pi)
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+template <typename T = double>
+class QuantileTransformer
+{
+private:
+    static_assert(std::is_floating_point_v<T>, "QuantileTransformer needs floating-point values");
+
+    static constexpr size_t block = 1024;
+    static constexpr double boundsThreshold = 1e-7;
+
+    // Everything transform reads for one interval, side by side
+    struct Knot
+    {
+        T quantile;
+        T value; // output at this quantile
+        T slope; // output per unit of input up to the next quantile, 0 for repeats
+        T tie;   // output for a value equal to this quantile (middle of its run of repeats)
+    };
+
+    struct Column
+    {
+        std::vector<T> quantiles;
+        std::vector<Knot> knots;
+        BinCutter<T> cutter;
+    };
+
+    size_t numQuantiles;
+    QuantileOutput output;
+    size_t sampleSize;
+    std::vector<Column> columns;
+    std::vector<double> outputTable; // output at each reference
+
+    void prepareColumn(Column &column)
+    {
+        std::vector<T> &q = column.quantiles;
+        // rounding in the interpolation can break monotonicity by an ulp
+        for (size_t i = 1; i < q.size(); ++i)
+        {
+            q[i] = std::max(q[i], q[i - 1]);
+        }
+
+        column.knots.resize(q.size());
+        for (size_t i = 0; i < q.size(); ++i)
+        {
+            Knot &knot = column.knots[i];
+            knot.quantile = q[i];
+            knot.value = static_cast<T>(outputTable[i]);
+            knot.slope = static_cast<T>(i + 1 < q.size() && q[i + 1] > q[i] ? (outputTable[i + 1] - outputTable[i]) / (static_cast<double>(q[i + 1]) - q[i]) : 0.0);
+        }
+
+        for (size_t first = 0; first < q.size();)
+        {
+            size_t last = first;
+            while (last + 1 < q.size() && q[last + 1] == q[first])
+            {
+                ++last;
+            }
+            const size_t middle = (first + last) / 2;
+            const double tie = (first + last) % 2 == 0 ? outputTable[middle] : 0.5 * (outputTable[middle] + outputTable[middle + 1]);
+            for (size_t i = first; i <= last; ++i)
+            {
+                column.knots[i].tie = static_cast<T>(tie);
+            }
+            first = last + 1;
+        }
+
+        column.cutter = BinCutter<T>(q);
+    }
+
+    // size quantiles of sorted (the column's non-missing values), interpolated
+    // linearly as np.percentile
+    void fillColumn(Column &column, const std::vector<double> &sorted, size_t size)
+    {
+        std::vector<T> &q = column.quantiles;
+        q.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            const double position = static_cast<double>(i) * (sorted.size() - 1) / (size - 1);
+            const size_t below = static_cast<size_t>(position);
+            const size_t above = std::min(below + 1, sorted.size() - 1);
+            q[i] = static_cast<T>(sorted[below] + (position - below) * (sorted[above] - sorted[below]));
+        }
+        prepareColumn(column);
+    }
+
+    void buildOutputTable(size_t size)
+    {
+        outputTable.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            const double reference = static_cast<double>(i) / (size - 1);
+            outputTable[i] = output == QuantileOutput::Uniform
+                                 ? reference
+                                 : inverse_normal_cdf(std::clamp(reference, boundsThreshold, 1.0 - boundsThreshold));
+        }
+    }
+
+    void checkColumn(size_t column) const
+    {
+        if (column >= columns.size())
+        {
+            throw std::out_of_range("Column index out of range");
+        }
+    }
+
+public:
+    explicit QuantileTransformer(size_t num_quantiles = 1000, QuantileOutput output_distribution = QuantileOutput::Uniform,
+                                 size_t sample_size = 0)
+        : numQuantiles(num_quantiles), output(output_distribution), sampleSize(sample_size)
+    {
+        if (numQuantiles < 2)
+        {
+            throw std::invalid_argument("At least two quantiles are required");
+        }
+    }
+
+    // features: rows x columns; exact quantiles from a sort of each column
+    // (of a strided sample of sample_size rows when sample_size > 0)
+    void fit(const std::vector<std::vector<T>> &features)
+    {
+        if (features.empty())
+        {
+            throw std::invalid_argument("Cannot fit a QuantileTransformer on empty data");
+        }
+        const size_t numFeatures = features[0].size();
+        const size_t rows = sampleSize > 0 ? std::min(sampleSize, features.size()) : features.size();
+        const size_t size = std::max<size_t>(2, std::min(numQuantiles, rows));
+        const double stride = static_cast<double>(features.size()) / rows;
+
+        buildOutputTable(size);
+        columns.assign(numFeatures, Column());
+        std::vector<double> values;
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            values.clear();
+            for (size_t i = 0; i < rows; ++i)
+            {
+                const double value = static_cast<double>(features[static_cast<size_t>(i * stride)][j]);
+                if (!std::isnan(value))
+                {
+                    values.push_back(value);
+                }
+            }
+            if (values.empty())
+            {
+                throw std::invalid_argument("Column " + std::to_string(j) + " has no non-missing values");
+            }
+            std::sort(values.begin(), values.end());
+            fillColumn(columns[j], values, size);
+        }
+    }
+
+    // A single column of n values (column 0 of the table), sampled like the
+    // row-major fit but without building one row vector per value
+    void fit(const T *values, size_t n)
+    {
+        if (n == 0)
+        {
+            throw std::invalid_argument("Cannot fit a QuantileTransformer on empty data");
+        }
+        const size_t rows = sampleSize > 0 ? std::min(sampleSize, n) : n;
+        const size_t size = std::max<size_t>(2, std::min(numQuantiles, rows));
+        const double stride = static_cast<double>(n) / rows;
+
+        std::vector<double> sorted;
+        sorted.reserve(rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            const double value = static_cast<double>(values[static_cast<size_t>(i * stride)]);
+            if (!std::isnan(value))
+            {
+                sorted.push_back(value);
+            }
+        }
+        if (sorted.empty())
+        {
+            throw std::invalid_argument("Column 0 has no non-missing values");
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        buildOutputTable(size);
+        columns.assign(1, Column());
+        fillColumn(columns[0], sorted, size);
+    }
+
+    // One sketch per column, for data streamed in chunks (see KllSketch)
+    void fit(const std::vector<KllSketch<T>> &sketches)
+    {
+        buildOutputTable(numQuantiles);
+        columns.assign(sketches.size(), Column());
+        for (size_t j = 0; j < sketches.size(); ++j)
+        {
+            if (sketches[j].empty())
+            {
+                throw std::invalid_argument("Column " + std::to_string(j) + " has an empty sketch");
+            }
+            std::vector<T> &q = columns[j].quantiles;
+            q.resize(numQuantiles);
+            for (size_t i = 0; i < numQuantiles; ++i)
+            {
+                q[i] = sketches[j].quantile(static_cast<double>(i) / (numQuantiles - 1));
+            }
+            prepareColumn(columns[j]);
+        }
+    }
+
+    // output[i] = transform of input[i] against the given column's table
+    void transform(const T *input, size_t n, size_t column, T *result, size_t num_threads = 0) const
+    {
+        checkColumn(column);
+        const Column &table = columns[column];
+        const Knot *knots = table.knots.data();
+        const T highest = table.quantiles.back();
+        const T highestValue = static_cast<T>(outputTable.back());
+
+        parallel_for(
+            n, [&](size_t begin, size_t end, size_t)
+            {
+                uint32_t codes[block];
+                for (size_t first = begin; first < end; first += block)
+                {
+                    const size_t count = std::min(block, end - first);
+                    const T *x = input + first;
+                    T *y = result + first;
+                    table.cutter.cut(x, count, codes);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const Knot &knot = knots[codes[i]];
+                        const T next = knots[codes[i] + 1].value;
+                        T value = knot.value + (x[i] - knot.quantile) * knot.slope;
+                        value = value > knot.value ? value : knot.value; // below the first quantile
+                        value = value < next ? value : next;
+                        value = x[i] == knot.quantile ? knot.tie : value;
+                        value = x[i] > highest ? highestValue : value;
+                        y[i] = x[i] != x[i] ? x[i] : value;
+                    }
+                } },
+            num_threads, 4 * block);
+    }
+
+    std::vector<T> transform(const std::vector<T> &input, size_t column, size_t num_threads = 0) const
+    {
+        std::vector<T> transformed(input.size());
+        transform(input.data(), input.size(), column, transformed.data(), num_threads);
+        return transformed;
+    }
+
+    std::vector<std::vector<T>> transform(const std::vector<std::vector<T>> &features) const
+    {
+        std::vector<std::vector<T>> transformed(features.size(), std::vector<T>(columns.size()));
+        std::vector<T> column(features.size());
+        std::vector<T> result(features.size());
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+            for (size_t i = 0; i < features.size(); ++i)
+            {
+                column[i] = features[i][j];
+            }
+            transform(column.data(), column.size(), j, result.data(), 1);
+            for (size_t i = 0; i < features.size(); ++i)
+            {
+                transformed[i][j] = result[i];
+            }
+        }
+        return transformed;
+    }
+
+    const std::vector<T> &getQuantiles(size_t column) const
+    {
+        checkColumn(column);
+        return columns[column].quantiles;
+    }
+};
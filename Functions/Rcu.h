@@ -0,0 +1,142 @@
+#pragma once
+
+#include "include_file.h"
+
+// Read-copy-update holder for read-mostly state (encoder vocabularies).
+//
+// Readers never lock: read() bumps a per-thread-slot counter, loads the
+// current snapshot pointer and drops the counter when the guard goes away.
+// The counters are cache-line padded and spread over slots, so concurrent
+// readers on different cores do not write the same line and read throughput
+// scales with threads.
+//
+// Writers are serialised by a mutex. update() copies the current snapshot,
+// lets the caller modify the copy, publishes it with one atomic store and
+// then waits for every reader that may still hold the old snapshot before
+// deleting it. Readers are split into two counter banks by epoch; the writer
+// flips the epoch and drains each bank in turn, so new readers never keep the
+// bank being drained busy (SRCU-style grace period).
+template <typename T>
+class RcuPointer
+{
+private:
+    static constexpr size_t slots = 64;
+
+    struct alignas(64) Counter
+    {
+        std::atomic<int64_t> readers{0};
+    };
+
+    std::atomic<const T *> current;
+    std::atomic<size_t> epoch{0};
+    mutable Counter counters[2][slots];
+    std::mutex writer;
+
+    static size_t threadSlot()
+    {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t slot = next.fetch_add(1, std::memory_order_relaxed) % slots;
+        return slot;
+    }
+
+    void drain(size_t bank)
+    {
+        for (const Counter &counter : counters[bank])
+        {
+            while (counter.readers.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Waits until no reader can still hold a snapshot published before the call
+    void synchronize()
+    {
+        for (int flip = 0; flip < 2; ++flip)
+        {
+            const size_t old = epoch.fetch_xor(1);
+            drain(old & 1);
+        }
+    }
+
+public:
+    // Keeps one snapshot alive; cheap to create, must not outlive the RcuPointer
+    class ReadGuard
+    {
+    private:
+        std::atomic<int64_t> *counter;
+        const T *snapshot;
+
+        friend class RcuPointer;
+
+        ReadGuard(std::atomic<int64_t> *c, const T *s) : counter(c), snapshot(s) {}
+
+    public:
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+
+        ReadGuard(ReadGuard &&other) noexcept : counter(other.counter), snapshot(other.snapshot)
+        {
+            other.counter = nullptr;
+        }
+
+        ~ReadGuard()
+        {
+            if (counter != nullptr)
+            {
+                counter->fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        const T &operator*() const
+        {
+            return *snapshot;
+        }
+
+        const T *operator->() const
+        {
+            return snapshot;
+        }
+    };
+
+    explicit RcuPointer(T initial = T()) : current(new T(std::move(initial))) {}
+
+    RcuPointer(const RcuPointer &) = delete;
+    RcuPointer &operator=(const RcuPointer &) = delete;
+
+    ~RcuPointer()
+    {
+        delete current.load();
+    }
+
+    ReadGuard read() const
+    {
+        std::atomic<int64_t> *counter = &counters[epoch.load() & 1][threadSlot()].readers;
+        counter->fetch_add(1);
+        return ReadGuard(counter, current.load());
+    }
+
+    // Copy-on-write: fn(T &copy) edits a private copy, which is then published.
+    // Returns once the previous snapshot has been reclaimed, so it must not be
+    // called while the calling thread holds a ReadGuard.
+    template <typename Fn>
+    void update(Fn &&fn)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        const T *old = current.load();
+        T *next = new T(*old);
+        try
+        {
+            fn(*next);
+        }
+        catch (...)
+        {
+            delete next;
+            throw;
+        }
+        current.store(next);
+        synchronize();
+        delete old;
+    }
+};
@@ -0,0 +1,476 @@
+#pragma once
+
+#include "include_file.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ML_FUNCTIONS_HAVE_MMAP 1
+#endif
+
+// Versioned binary format for fitted preprocessing state.
+//
+// A file is a sequence of objects; each starts with a 24-byte header
+//   "MLFS" | u32 format version | u32 SerialKind | u32 SerialType | u64 byte-order mark
+// followed by the object's fields. Scalars are written as-is; arrays as a u64
+// element count followed by the raw elements, starting on an 8-byte boundary.
+// Because arrays are aligned and stored in native layout, a reader over a
+// memory-mapped file hands them out as views into the mapping (FlatArray)
+// instead of copying: a vocabulary's string pool, offset table and hash slots
+// are used straight from the page cache, so load time does not grow with the
+// vocabulary size. Small arrays (statistics, bin edges) are simply copied.
+//
+// Files are native-endian; the byte-order mark rejects a file written on a
+// machine of the other endianness. Loading checks the structure (sizes,
+// bounds, kinds, types), not the contents, so only load trusted files.
+
+enum class SerialKind : uint32_t
+{
+    FeatureScaler = 1,
+    SimpleImputer = 2,
+    LabelEncoder = 3,
+    OneHotEncoder = 4,
+    UniformBinning = 5,
+    QuantileBinning = 6,
+    KMeansBinning = 7,
+    ColumnTable = 8,
+    PCA = 9,
+};
+
+// Element type an object was fitted on, so a FeatureScaler<float> file is
+// not silently read as FeatureScaler<double>
+enum class SerialType : uint32_t
+{
+    None = 0,
+    String = 1,
+    Float32 = 2,
+    Float64 = 3,
+    Int32 = 4,
+    Int64 = 5,
+};
+
+template <typename T>
+constexpr SerialType serial_type()
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return SerialType::Float32;
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return SerialType::Float64;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4)
+    {
+        return SerialType::Int32;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 8)
+    {
+        return SerialType::Int64;
+    }
+    else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+    {
+        return SerialType::String;
+    }
+    else
+    {
+        return SerialType::None;
+    }
+}
+
+constexpr uint32_t serial_format_version = 1;
+
+// Read-only view of a whole file: mmap where available, else read into memory
+class MappedFile
+{
+private:
+    const char *bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<char> buffer;
+
+    MappedFile() = default;
+
+public:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+#if defined(ML_FUNCTIONS_HAVE_MMAP)
+        if (mapped)
+        {
+            munmap(const_cast<char *>(bytes), length);
+        }
+#endif
+    }
+
+    static std::shared_ptr<const MappedFile> open(const std::string &path)
+    {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+#if defined(ML_FUNCTIONS_HAVE_MMAP)
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) != 0)
+        {
+            ::close(descriptor);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        file->length = static_cast<size_t>(status.st_size);
+        if (file->length > 0)
+        {
+            void *address = mmap(nullptr, file->length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED)
+            {
+                ::close(descriptor);
+                throw std::runtime_error("Cannot map " + path);
+            }
+            file->bytes = static_cast<const char *>(address);
+            file->mapped = true;
+        }
+        ::close(descriptor); // the mapping stays valid
+#else
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        file->buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        file->bytes = file->buffer.data();
+        file->length = file->buffer.size();
+#endif
+        return file;
+    }
+
+    // In-memory bytes, e.g. received over the network
+    static std::shared_ptr<const MappedFile> fromBuffer(std::vector<char> bytes)
+    {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+        file->buffer = std::move(bytes);
+        file->bytes = file->buffer.data();
+        file->length = file->buffer.size();
+        return file;
+    }
+
+    const char *data() const
+    {
+        return bytes;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+};
+
+// Array that either owns its elements or views memory kept alive by a
+// shared owner (a MappedFile). Reads are the same in both modes; mutable()
+// turns a view into an owned copy first, so loaded state can still be
+// extended. Copies of a view share the mapping.
+template <typename T>
+class FlatArray
+{
+private:
+    std::vector<T> items;
+    const T *view = nullptr;
+    size_t viewSize = 0;
+    std::shared_ptr<const void> backing;
+
+public:
+    FlatArray() = default;
+    FlatArray(std::vector<T> values) : items(std::move(values)) {}
+    FlatArray(std::initializer_list<T> values) : items(values) {}
+
+    static FlatArray viewOf(const T *data, size_t size, std::shared_ptr<const void> owner)
+    {
+        FlatArray array;
+        array.view = data;
+        array.viewSize = size;
+        array.backing = std::move(owner);
+        return array;
+    }
+
+    bool isView() const
+    {
+        return view != nullptr;
+    }
+
+    const T *data() const
+    {
+        return view != nullptr ? view : items.data();
+    }
+
+    size_t size() const
+    {
+        return view != nullptr ? viewSize : items.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    const T &operator[](size_t i) const
+    {
+        return data()[i];
+    }
+
+    const T &back() const
+    {
+        return data()[size() - 1];
+    }
+
+    const T *begin() const
+    {
+        return data();
+    }
+
+    const T *end() const
+    {
+        return data() + size();
+    }
+
+    std::vector<T> &mutableItems()
+    {
+        if (view != nullptr)
+        {
+            items.assign(view, view + viewSize);
+            view = nullptr;
+            viewSize = 0;
+            backing.reset();
+        }
+        return items;
+    }
+};
+
+class BinaryWriter
+{
+private:
+    std::vector<char> bytes;
+
+    void pad()
+    {
+        bytes.resize((bytes.size() + 7) & ~size_t(7), 0);
+    }
+
+public:
+    void writeHeader(SerialKind kind, SerialType type)
+    {
+        pad();
+        const char magic[4] = {'M', 'L', 'F', 'S'};
+        bytes.insert(bytes.end(), magic, magic + 4);
+        write<uint32_t>(serial_format_version);
+        write<uint32_t>(static_cast<uint32_t>(kind));
+        write<uint32_t>(static_cast<uint32_t>(type));
+        write<uint64_t>(0x0102030405060708ULL);
+    }
+
+    template <typename T>
+    void write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+        const char *raw = reinterpret_cast<const char *>(&value);
+        bytes.insert(bytes.end(), raw, raw + sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(const T *values, size_t n)
+    {
+        static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8, "Arrays must be flat and at most 8-byte aligned");
+        pad();
+        write<uint64_t>(n);
+        const char *raw = reinterpret_cast<const char *>(values);
+        bytes.insert(bytes.end(), raw, raw + n * sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(const std::vector<T> &values)
+    {
+        writeArray(values.data(), values.size());
+    }
+
+    template <typename T>
+    void writeArray(const FlatArray<T> &values)
+    {
+        writeArray(values.data(), values.size());
+    }
+
+    const std::vector<char> &buffer() const
+    {
+        return bytes;
+    }
+
+    std::vector<char> release()
+    {
+        return std::move(bytes);
+    }
+
+    // Writes to path + ".tmp" and renames over path, so a process loading
+    // path never sees a half-written file
+    void writeFile(const std::string &path) const
+    {
+        const std::string temporary = path + ".tmp";
+        {
+            std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+            stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            if (!stream)
+            {
+                throw std::runtime_error("Cannot write " + temporary);
+            }
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            throw std::runtime_error("Cannot rename " + temporary + " to " + path);
+        }
+    }
+};
+
+class BinaryReader
+{
+private:
+    std::shared_ptr<const MappedFile> file;
+    size_t position = 0;
+    uint32_t formatVersion = 0;
+
+    const char *take(size_t n)
+    {
+        if (n > file->size() - position)
+        {
+            throw std::runtime_error("Serialized data is truncated");
+        }
+        const char *at = file->data() + position;
+        position += n;
+        return at;
+    }
+
+    void pad()
+    {
+        position = std::min((position + 7) & ~size_t(7), file->size());
+    }
+
+public:
+    explicit BinaryReader(std::shared_ptr<const MappedFile> source) : file(std::move(source)) {}
+
+    explicit BinaryReader(std::vector<char> bytes) : file(MappedFile::fromBuffer(std::move(bytes))) {}
+
+    // Checks the next object header and returns its format version
+    uint32_t readHeader(SerialKind kind, SerialType type)
+    {
+        pad();
+        if (std::memcmp(take(4), "MLFS", 4) != 0)
+        {
+            throw std::runtime_error("Not a serialized object (bad magic)");
+        }
+        formatVersion = read<uint32_t>();
+        const uint32_t storedKind = read<uint32_t>();
+        const uint32_t storedType = read<uint32_t>();
+        if (read<uint64_t>() != 0x0102030405060708ULL)
+        {
+            throw std::runtime_error("Serialized data has a different byte order");
+        }
+        if (formatVersion == 0 || formatVersion > serial_format_version)
+        {
+            throw std::runtime_error("Unsupported format version " + std::to_string(formatVersion));
+        }
+        if (storedKind != static_cast<uint32_t>(kind))
+        {
+            throw std::runtime_error("Serialized object is of kind " + std::to_string(storedKind) +
+                                     ", expected " + std::to_string(static_cast<uint32_t>(kind)));
+        }
+        if (storedType != static_cast<uint32_t>(type))
+        {
+            throw std::runtime_error("Serialized object has element type " + std::to_string(storedType) +
+                                     ", expected " + std::to_string(static_cast<uint32_t>(type)));
+        }
+        return formatVersion;
+    }
+
+    uint32_t version() const
+    {
+        return formatVersion;
+    }
+
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // Zero-copy view of the next array; keeps the file alive
+    template <typename T>
+    FlatArray<T> readArray()
+    {
+        static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8, "Arrays must be flat and at most 8-byte aligned");
+        pad();
+        const uint64_t n = read<uint64_t>();
+        if (n > (file->size() - position) / sizeof(T))
+        {
+            throw std::runtime_error("Serialized array is truncated");
+        }
+        const char *at = take(n * sizeof(T));
+        if (reinterpret_cast<uintptr_t>(at) % alignof(T) != 0)
+        {
+            throw std::runtime_error("Serialized array is misaligned");
+        }
+        return FlatArray<T>::viewOf(reinterpret_cast<const T *>(at), n, file);
+    }
+
+    // Owned copy of the next array
+    template <typename T>
+    std::vector<T> readVector()
+    {
+        const FlatArray<T> values = readArray<T>();
+        return std::vector<T>(values.begin(), values.end());
+    }
+
+    bool atEnd() const
+    {
+        return position == file->size();
+    }
+
+    size_t tell() const
+    {
+        return position;
+    }
+
+    // Jumps to an absolute offset, e.g. a directory found through a footer
+    void seek(size_t offset)
+    {
+        if (offset > file->size())
+        {
+            throw std::runtime_error("Serialized offset is out of range");
+        }
+        position = offset;
+    }
+};
+
+// One object per file; Object provides save(BinaryWriter &) const and
+// static load(BinaryReader &)
+template <typename Object>
+void save_object(const Object &object, const std::string &path)
+{
+    BinaryWriter writer;
+    object.save(writer);
+    writer.writeFile(path);
+}
+
+template <typename Object>
+Object load_object(const std::string &path)
+{
+    BinaryReader reader(MappedFile::open(path));
+    Object object = Object::load(reader);
+    if (!reader.atEnd())
+    {
+        throw std::runtime_error("Unexpected data after the serialized object in " + path);
+    }
+    return object;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "include_file.h"
+
+// Small SIMD kernels shared by the Functions/ classes.
+// AVX2 paths are used when the translation unit is built with -mavx2 (or
+// -march=native); every kernel has a portable fallback written so that the
+// compiler can auto-vectorise it for other targets.
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+inline double horizontal_sum(__m256d v)
+{
+    const __m128d low = _mm256_castpd256_pd128(v);
+    const __m128d high = _mm256_extractf128_pd(v, 1);
+    const __m128d pair = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+inline __m256d multiply_add(__m256d a, __m256d b, __m256d c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+#endif
+
+// sum_j mask[j] * (a[j] - b[j])^2 with mask[j] in {0, 1}
+// (a must not contain NaN where mask is 0, callers zero those entries)
+inline double masked_squared_distance(const double *a, const double *mask, const double *b, size_t n)
+{
+    size_t j = 0;
+    double sum = 0.0;
+#if defined(__AVX2__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; j + 8 <= n; j += 8)
+    {
+        const __m256d d0 = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j)), _mm256_loadu_pd(mask + j));
+        const __m256d d1 = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(a + j + 4), _mm256_loadu_pd(b + j + 4)), _mm256_loadu_pd(mask + j + 4));
+        acc0 = multiply_add(d0, d0, acc0);
+        acc1 = multiply_add(d1, d1, acc1);
+    }
+    sum = horizontal_sum(_mm256_add_pd(acc0, acc1));
+#else
+    double acc[4] = {0.0, 0.0, 0.0, 0.0};
+    for (; j + 4 <= n; j += 4)
+    {
+        for (size_t l = 0; l < 4; ++l)
+        {
+            const double diff = (a[j + l] - b[j + l]) * mask[j + l];
+            acc[l] += diff * diff;
+        }
+    }
+    sum = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+    for (; j < n; ++j)
+    {
+        const double diff = (a[j] - b[j]) * mask[j];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// Sets bit i of words[i / 64] when values[i] is NaN (compare + movemask,
+// 4 lanes for double, 8 for float), words must hold (n + 63) / 64 entries.
+// Returns true when any NaN was found.
+template <typename T>
+inline bool nan_bitmask(const T *values, size_t n, uint64_t *words)
+{
+    static_assert(std::is_floating_point_v<T>, "nan_bitmask needs floating-point values");
+    uint64_t any = 0;
+    for (size_t w = 0; w * 64 < n; ++w)
+    {
+        const T *block = values + w * 64;
+        const size_t count = std::min<size_t>(64, n - w * 64);
+        uint64_t bits = 0;
+        size_t i = 0;
+#if defined(__AVX2__)
+        if constexpr (std::is_same_v<T, double>)
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m256d v = _mm256_loadu_pd(block + i);
+                const uint64_t nan = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q)));
+                bits |= nan << i;
+            }
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 v = _mm256_loadu_ps(block + i);
+                const uint64_t nan = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+                bits |= nan << i;
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            bits |= static_cast<uint64_t>(block[i] != block[i]) << i;
+        }
+        words[w] = bits;
+        any |= bits;
+    }
+    return any != 0;
+}
+
+#if defined(__AVX2__)
+inline float horizontal_sum(__m256 v)
+{
+    const __m128 low = _mm256_castps256_ps128(v);
+    const __m128 high = _mm256_extractf128_ps(v, 1);
+    __m128 sum = _mm_add_ps(low, high);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+    return _mm_cvtss_f32(sum);
+}
+
+inline __m256 multiply_add(__m256 a, __m256 b, __m256 c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+// sum_j (a[j] - b[j])^2
+template <typename T>
+inline T squared_distance(const T *a, const T *b, size_t n)
+{
+    size_t j = 0;
+    T sum = T(0);
+#if defined(__AVX2__)
+    if constexpr (std::is_same_v<T, double>)
+    {
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        for (; j + 8 <= n; j += 8)
+        {
+            const __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j));
+            const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(a + j + 4), _mm256_loadu_pd(b + j + 4));
+            acc0 = multiply_add(d0, d0, acc0);
+            acc1 = multiply_add(d1, d1, acc1);
+        }
+        sum = horizontal_sum(_mm256_add_pd(acc0, acc1));
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for (; j + 16 <= n; j += 16)
+        {
+            const __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + j), _mm256_loadu_ps(b + j));
+            const __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + j + 8), _mm256_loadu_ps(b + j + 8));
+            acc0 = multiply_add(d0, d0, acc0);
+            acc1 = multiply_add(d1, d1, acc1);
+        }
+        sum = horizontal_sum(_mm256_add_ps(acc0, acc1));
+    }
+#endif
+    T acc[4] = {T(0), T(0), T(0), T(0)};
+    for (; j + 4 <= n; j += 4)
+    {
+        for (size_t l = 0; l < 4; ++l)
+        {
+            const T diff = a[j + l] - b[j + l];
+            acc[l] += diff * diff;
+        }
+    }
+    sum += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    for (; j < n; ++j)
+    {
+        const T diff = a[j] - b[j];
+        sum += diff * diff;
+    }
+    return sum;
+}
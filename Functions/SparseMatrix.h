@@ -0,0 +1,51 @@
+#pragma once
+
+#include "include_file.h"
+
+// Compressed sparse row (CSR) matrix.
+// Row i stores its column indices in indices[indptr[i] .. indptr[i + 1]) and
+// the matching values in values[...]. When values is empty every stored
+// entry is 1 (an index-only / pattern matrix, e.g. one-hot output), which
+// halves the memory of binary features.
+template <typename V>
+struct CsrMatrix
+{
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<size_t> indptr{0};
+    std::vector<uint32_t> indices;
+    std::vector<V> values;
+
+    size_t nnz() const
+    {
+        return indices.size();
+    }
+
+    bool isPattern() const
+    {
+        return values.empty() && !indices.empty();
+    }
+
+    V value(size_t k) const
+    {
+        return values.empty() ? V(1) : values[k];
+    }
+
+    size_t rowSize(size_t row) const
+    {
+        return indptr[row + 1] - indptr[row];
+    }
+
+    std::vector<std::vector<V>> toDense() const
+    {
+        std::vector<std::vector<V>> dense(rows, std::vector<V>(cols, V(0)));
+        for (size_t i = 0; i < rows; ++i)
+        {
+            for (size_t k = indptr[i]; k < indptr[i + 1]; ++k)
+            {
+                dense[i][indices[k]] += value(k);
+            }
+        }
+        return dense;
+    }
+};
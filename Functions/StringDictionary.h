@@ -0,0 +1,217 @@
+#pragma once
+
+#include "include_file.h"
+#include "Hash.h"
+#include "Serialization.h"
+
+// Flat open-addressing dictionary string -> dense code (0 .. size()-1 in
+// insertion order).
+//
+// - Strings are interned into one contiguous pool; entries are offsets into
+//   the pool, not pointers, so the dictionary copies as a few flat arrays.
+// - Each slot stores the precomputed 64-bit hash next to the code, so a probe
+//   only reads the pool when the full hash matches.
+// - Lookups take std::string_view, no std::string is built per lookup.
+// - Decoding is an index into the offset table.
+// - findBatch hashes a block of keys first and prefetches their slots before
+//   probing, so the cache misses of a block overlap.
+// - save writes the pool, offset table and slots as they are; load maps them
+//   back as views (FlatArray), so a loaded dictionary answers lookups
+//   without rebuilding or copying anything. The first insert into a loaded
+//   dictionary copies it into owned memory.
+// Linear probing, load factor kept at or below 1/2.
+class StringDictionary
+{
+public:
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+private:
+    struct Slot
+    {
+        uint64_t hash;
+        uint32_t code;       // npos when empty
+        uint32_t unused = 0; // explicit padding, keeps saved files deterministic
+    };
+
+    static constexpr size_t batch = 16;
+
+    FlatArray<char> pool;
+    FlatArray<uint64_t> offsets{0}; // size() + 1 entries
+    FlatArray<Slot> slots;
+    uint64_t seed;
+
+    size_t mask() const
+    {
+        return slots.size() - 1;
+    }
+
+    bool matches(const Slot &slot, uint64_t hash, std::string_view key) const
+    {
+        return slot.hash == hash && at(slot.code) == key;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Slot> resized(capacity, Slot{0, npos});
+        const size_t resizedMask = capacity - 1;
+        for (const Slot &slot : slots)
+        {
+            if (slot.code == npos)
+            {
+                continue;
+            }
+            size_t position = slot.hash & resizedMask;
+            while (resized[position].code != npos)
+            {
+                position = (position + 1) & resizedMask;
+            }
+            resized[position] = slot;
+        }
+        slots.mutableItems().swap(resized);
+    }
+
+public:
+    explicit StringDictionary(uint64_t hash_seed = 0) : slots(std::vector<Slot>(16, Slot{0, npos})), seed(hash_seed) {}
+
+    uint64_t hash(std::string_view key) const
+    {
+        return xxh64(key, seed);
+    }
+
+    void reserve(size_t entries)
+    {
+        size_t capacity = slots.size();
+        while (capacity < 2 * entries)
+        {
+            capacity *= 2;
+        }
+        if (capacity != slots.size())
+        {
+            rehash(capacity);
+        }
+        offsets.mutableItems().reserve(entries + 1);
+    }
+
+    uint32_t find(std::string_view key, uint64_t keyHash) const
+    {
+        for (size_t position = keyHash & mask();; position = (position + 1) & mask())
+        {
+            const Slot &slot = slots[position];
+            if (slot.code == npos)
+            {
+                return npos;
+            }
+            if (matches(slot, keyHash, key))
+            {
+                return slot.code;
+            }
+        }
+    }
+
+    uint32_t find(std::string_view key) const
+    {
+        return find(key, hash(key));
+    }
+
+    // Code of key, adding it when it is new
+    uint32_t insert(std::string_view key)
+    {
+        const uint64_t keyHash = hash(key);
+        size_t position = keyHash & mask();
+        for (;; position = (position + 1) & mask())
+        {
+            const Slot &slot = slots[position];
+            if (slot.code == npos)
+            {
+                break;
+            }
+            if (matches(slot, keyHash, key))
+            {
+                return slot.code;
+            }
+        }
+
+        if (size() >= npos - 1)
+        {
+            throw std::length_error("StringDictionary is full");
+        }
+
+        const uint32_t code = static_cast<uint32_t>(size());
+        std::vector<char> &chars = pool.mutableItems();
+        chars.insert(chars.end(), key.begin(), key.end());
+        offsets.mutableItems().push_back(chars.size());
+        slots.mutableItems()[position] = Slot{keyHash, code};
+
+        if (2 * size() > slots.size())
+        {
+            rehash(2 * slots.size());
+        }
+        return code;
+    }
+
+    // codes[i] = find(keys[i]) (npos when missing); Key is any type
+    // convertible to std::string_view
+    template <typename Key>
+    void findBatch(const Key *keys, size_t n, uint32_t *codes) const
+    {
+        uint64_t hashes[batch];
+        for (size_t first = 0; first < n; first += batch)
+        {
+            const size_t count = std::min(batch, n - first);
+            for (size_t j = 0; j < count; ++j)
+            {
+                hashes[j] = hash(std::string_view(keys[first + j]));
+                __builtin_prefetch(&slots[hashes[j] & mask()]);
+            }
+            for (size_t j = 0; j < count; ++j)
+            {
+                codes[first + j] = find(std::string_view(keys[first + j]), hashes[j]);
+            }
+        }
+    }
+
+    std::string_view at(uint32_t code) const
+    {
+        return std::string_view(pool.data() + offsets[code], offsets[code + 1] - offsets[code]);
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return find(key) != npos;
+    }
+
+    size_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void save(BinaryWriter &writer) const
+    {
+        writer.write<uint64_t>(seed);
+        writer.writeArray(pool);
+        writer.writeArray(offsets);
+        writer.writeArray(slots);
+    }
+
+    // O(1): the arrays stay in the reader's file; only their sizes are checked
+    static StringDictionary load(BinaryReader &reader)
+    {
+        StringDictionary dictionary(reader.read<uint64_t>());
+        dictionary.pool = reader.readArray<char>();
+        dictionary.offsets = reader.readArray<uint64_t>();
+        dictionary.slots = reader.readArray<Slot>();
+
+        const size_t capacity = dictionary.slots.size();
+        if (dictionary.offsets.empty() || dictionary.offsets[0] != 0 || dictionary.offsets.back() != dictionary.pool.size() ||
+            capacity < 16 || (capacity & (capacity - 1)) != 0 || 2 * dictionary.size() > capacity)
+        {
+            throw std::runtime_error("Corrupt StringDictionary");
+        }
+        return dictionary;
+    }
+};
@@ -0,0 +1,328 @@
+#pragma once
+
+// LOG Transform , reciprocal transform , square root transform ML Functions
+
+#include "include_file.h"
+#include "Arena.h"
+#include "Metrics.h"
+#include "Precision.h"
+#include "HashingVectorizer.h"
+#include "PolynomialFeatures.h"
+#include "PowerTransformer.h"
+#include "QuantileTransformer.h"
+#include "VectorMath.h"
+#include "SparseMatrix.h"
+#include "StringDictionary.h"
+
+// Every numeric transform is templated on the storage type: float data is
+// transformed in float (see Precision.h), statistics and fitted parameters
+// are accumulated in double.
+// Elementwise transforms accept std::vector or std::pmr::vector input and
+// have an overload that allocates the result from a std::pmr::memory_resource
+// (e.g. a BumpArena reset after each batch), so a steady-state pipeline makes
+// no heap allocations; standardize and minMaxScale also write into caller
+// buffers. Fits (lambda, quantile tables) still allocate their fitted state.
+// Each operation is recorded as ml_transformer.<operation> (Metrics.h).
+class MLTransformer
+{
+private:
+    enum class Operation
+    {
+        Standardize,
+        MinMaxScale,
+        FeatureHashing,
+        PolynomialFeatures,
+        OneHotEncode,
+        Log,
+        Reciprocal,
+        SquareRoot,
+        BoxCox,
+        QuantileTransform,
+        FitBoxCoxLambda,
+        Count
+    };
+
+    static OperationMetrics &metrics(Operation operation)
+    {
+        static const std::array<OperationMetrics *, static_cast<size_t>(Operation::Count)> all = []
+        {
+            const char *names[] = {"standardize", "min_max_scale", "feature_hashing", "polynomial_features", "one_hot_encode", "log",
+                                   "reciprocal", "square_root", "box_cox", "quantile_transform", "fit_box_cox_lambda"};
+            std::array<OperationMetrics *, static_cast<size_t>(Operation::Count)> registered{};
+            for (size_t i = 0; i < registered.size(); ++i)
+            {
+                registered[i] = &MetricsRegistry::global().operation(std::string("ml_transformer.") + names[i]);
+            }
+            return registered;
+        }();
+        return *all[static_cast<size_t>(operation)];
+    }
+
+public:
+    template <typename T>
+    void standardize(const T *data, size_t n, scaled_t<T> *transformedData)
+    {
+        const ScopedOperation timing(metrics(Operation::Standardize), n, n * sizeof(T));
+        using R = scaled_t<T>;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            sum += static_cast<double>(data[i]);
+            sumSquares += static_cast<double>(data[i]) * static_cast<double>(data[i]);
+        }
+        double mean = sum / n;
+        double stddev = std::sqrt(sumSquares / n - mean * mean);
+
+        std::transform(data, data + n, transformedData,
+                       [mean = static_cast<R>(mean), stddev = static_cast<R>(stddev)](const T &val)
+                       { return (static_cast<R>(val) - mean) / stddev; });
+    }
+
+    template <typename T, typename Alloc>
+    std::vector<scaled_t<T>> standardize(const std::vector<T, Alloc> &data)
+    {
+        std::vector<scaled_t<T>> transformedData(data.size());
+        standardize(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<scaled_t<T>> standardize(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+    {
+        std::pmr::vector<scaled_t<T>> transformedData(data.size(), resource);
+        standardize(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T>
+    void minMaxScale(const T *data, size_t n, double minVal, double maxVal, scaled_t<T> *transformedData)
+    {
+        const ScopedOperation timing(metrics(Operation::MinMaxScale), n, n * sizeof(T));
+        using R = scaled_t<T>;
+        const auto [minData, maxData] = std::minmax_element(data, data + n);
+
+        // one multiply-add per value in the storage type
+        const double scale = (maxVal - minVal) / (static_cast<double>(*maxData) - static_cast<double>(*minData));
+        const double shift = minVal - static_cast<double>(*minData) * scale;
+
+        std::transform(data, data + n, transformedData,
+                       [scale = static_cast<R>(scale), shift = static_cast<R>(shift)](const T &val)
+                       { return static_cast<R>(val) * scale + shift; });
+    }
+
+    template <typename T, typename Alloc>
+    std::vector<scaled_t<T>> minMaxScale(const std::vector<T, Alloc> &data, double minVal, double maxVal)
+    {
+        std::vector<scaled_t<T>> transformedData(data.size());
+        minMaxScale(data.data(), data.size(), minVal, maxVal, transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<scaled_t<T>> minMaxScale(const std::vector<T, Alloc> &data, double minVal, double maxVal, std::pmr::memory_resource *resource)
+    {
+        std::pmr::vector<scaled_t<T>> transformedData(data.size(), resource);
+        minMaxScale(data.data(), data.size(), minVal, maxVal, transformedData.data());
+        return transformedData;
+    }
+
+    // Token counts per hashed column; XXH64 keeps the columns identical
+    // across machines (std::hash is implementation-defined)
+    std::vector<double> featureHashing(const std::vector<std::string> &data, size_t numFeatures)
+    {
+        ScopedOperation timing(metrics(Operation::FeatureHashing), data.size());
+        const HashingVectorizer vectorizer(numFeatures, 0, false);
+        std::vector<double> hashedData(numFeatures, 0.0);
+        size_t bytes = 0;
+        for (const auto &item : data)
+        {
+            hashedData[vectorizer.column(vectorizer.hash(item))]++;
+            bytes += item.size();
+        }
+        timing.setBytes(bytes);
+        return hashedData;
+    }
+
+    // Many bags at once, signed-hash trick, sparse output
+    CsrMatrix<double> featureHashing(const std::vector<std::vector<std::string>> &rows, size_t numFeatures, uint64_t seed = 0, size_t numThreads = 0)
+    {
+        const ScopedOperation timing(metrics(Operation::FeatureHashing), rows.size());
+        return HashingVectorizer(numFeatures, seed).transform(rows, numThreads);
+    }
+
+    // x, x^2, .., x^degree per value, each power one multiplication of the previous
+    template <typename T>
+    std::vector<std::vector<T>> addPolynomialFeatures(const std::vector<T> &data, size_t degree)
+    {
+        const ScopedOperation timing(metrics(Operation::PolynomialFeatures), data.size(), data.size() * sizeof(T));
+        PolynomialFeatures<T> expander(degree);
+        expander.fit(1);
+        const std::vector<T> expanded = expander.transform(data);
+
+        std::vector<std::vector<T>> polynomialFeatures;
+        polynomialFeatures.reserve(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            polynomialFeatures.emplace_back(expanded.begin() + i * degree, expanded.begin() + (i + 1) * degree);
+        }
+        return polynomialFeatures;
+    }
+
+    // All monomials up to degree over a row-major rows x cols matrix, returned
+    // as one contiguous row-major block (see PolynomialFeatures for the order)
+    template <typename T>
+    std::vector<T> addPolynomialFeatures(const std::vector<T> &data, size_t cols, size_t degree, bool interactionOnly = false, size_t numThreads = 0)
+    {
+        const ScopedOperation timing(metrics(Operation::PolynomialFeatures), cols == 0 ? 0 : data.size() / cols, data.size() * sizeof(T));
+        PolynomialFeatures<T> expander(degree, interactionOnly);
+        expander.fit(cols);
+        return expander.transform(data, numThreads);
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<T> addPolynomialFeatures(const std::vector<T, Alloc> &data, size_t cols, size_t degree, bool interactionOnly, size_t numThreads,
+                                              std::pmr::memory_resource *resource)
+    {
+        const ScopedOperation timing(metrics(Operation::PolynomialFeatures), cols == 0 ? 0 : data.size() / cols, data.size() * sizeof(T));
+        PolynomialFeatures<T> expander(degree, interactionOnly);
+        expander.fit(cols);
+        if (data.size() % cols != 0)
+        {
+            throw std::invalid_argument("Input size is not a multiple of the number of features");
+        }
+        const size_t rows = data.size() / cols;
+        std::pmr::vector<T> expanded(rows * expander.getNumOutputFeatures(), resource);
+        expander.transform(data.data(), rows, expanded.data(), numThreads);
+        return expanded;
+    }
+
+    // One column per distinct category (first-seen order), returned as an
+    // index-only CSR matrix: one stored entry per row instead of a dense row
+    CsrMatrix<double> oneHotEncode(const std::vector<std::string> &categories)
+    {
+        ScopedOperation timing(metrics(Operation::OneHotEncode), categories.size());
+        StringDictionary categoryIndices;
+        CsrMatrix<double> encodedCategories;
+        encodedCategories.rows = categories.size();
+        encodedCategories.indptr.resize(categories.size() + 1);
+        encodedCategories.indices.resize(categories.size());
+        size_t bytes = 0;
+
+        for (size_t i = 0; i < categories.size(); ++i)
+        {
+            encodedCategories.indices[i] = categoryIndices.insert(categories[i]);
+            encodedCategories.indptr[i + 1] = i + 1;
+            bytes += categories[i].size();
+        }
+        timing.setBytes(bytes);
+        encodedCategories.cols = categoryIndices.size();
+
+        return encodedCategories;
+    };
+
+    std::vector<std::vector<double>> oneHotEncodeDense(const std::vector<std::string> &categories)
+    {
+        return oneHotEncode(categories).toDense();
+    }
+
+    template <typename T, typename Alloc>
+    std::vector<T> logTransform(const std::vector<T, Alloc> &data)
+    {
+        const ScopedOperation timing(metrics(Operation::Log), data.size(), data.size() * sizeof(T));
+        std::vector<T> transformedData(data.size());
+        vector_log(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<T> logTransform(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+    {
+        const ScopedOperation timing(metrics(Operation::Log), data.size(), data.size() * sizeof(T));
+        std::pmr::vector<T> transformedData(data.size(), resource);
+        vector_log(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::vector<T> reciprocalTransform(const std::vector<T, Alloc> &data)
+    {
+        const ScopedOperation timing(metrics(Operation::Reciprocal), data.size(), data.size() * sizeof(T));
+        std::vector<T> transformedData(data.size());
+        vector_reciprocal(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<T> reciprocalTransform(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+    {
+        const ScopedOperation timing(metrics(Operation::Reciprocal), data.size(), data.size() * sizeof(T));
+        std::pmr::vector<T> transformedData(data.size(), resource);
+        vector_reciprocal(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::vector<T> squareRootTransform(const std::vector<T, Alloc> &data)
+    {
+        const ScopedOperation timing(metrics(Operation::SquareRoot), data.size(), data.size() * sizeof(T));
+        std::vector<T> transformedData(data.size());
+        vector_sqrt(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<T> squareRootTransform(const std::vector<T, Alloc> &data, std::pmr::memory_resource *resource)
+    {
+        const ScopedOperation timing(metrics(Operation::SquareRoot), data.size(), data.size() * sizeof(T));
+        std::pmr::vector<T> transformedData(data.size(), resource);
+        vector_sqrt(data.data(), data.size(), transformedData.data());
+        return transformedData;
+    }
+
+    // log(x) when lambda is close to zero, else (x^lambda - 1) / lambda for
+    // x > 0 and -(-x)^lambda otherwise, selected per lane without branching
+    template <typename T, typename Alloc>
+    std::vector<T> boxCoxTransform(const std::vector<T, Alloc> &data, double lambda)
+    {
+        const ScopedOperation timing(metrics(Operation::BoxCox), data.size(), data.size() * sizeof(T));
+        std::vector<T> transformedData(data.size());
+        vector_box_cox(data.data(), data.size(), static_cast<T>(lambda), transformedData.data());
+        return transformedData;
+    }
+
+    template <typename T, typename Alloc>
+    std::pmr::vector<T> boxCoxTransform(const std::vector<T, Alloc> &data, double lambda, std::pmr::memory_resource *resource)
+    {
+        const ScopedOperation timing(metrics(Operation::BoxCox), data.size(), data.size() * sizeof(T));
+        std::pmr::vector<T> transformedData(data.size(), resource);
+        vector_box_cox(data.data(), data.size(), static_cast<T>(lambda), transformedData.data());
+        return transformedData;
+    }
+
+    // Rank-based map to uniform [0, 1] (or standard normal) through a table of
+    // numQuantiles quantiles of the data itself
+    template <typename T>
+    std::vector<T> quantileTransform(const std::vector<T> &data, size_t numQuantiles = 1000, bool normalOutput = false, size_t numThreads = 0)
+    {
+        const ScopedOperation timing(metrics(Operation::QuantileTransform), data.size(), data.size() * sizeof(T));
+        QuantileTransformer<T> quantiles(numQuantiles, normalOutput ? QuantileOutput::Normal : QuantileOutput::Uniform);
+        quantiles.fit(data.data(), data.size());
+        return quantiles.transform(data, 0, numThreads);
+    }
+
+    // Maximum-likelihood Box-Cox lambda of strictly positive data
+    template <typename T>
+    double fitBoxCoxLambda(const std::vector<T> &data, size_t numThreads = 0)
+    {
+        const ScopedOperation timing(metrics(Operation::FitBoxCoxLambda), data.size(), data.size() * sizeof(T));
+        return PowerTransformer(PowerMethod::BoxCox, 0, numThreads).fitLambda(data.data(), data.size());
+    }
+
+    // Box-Cox with the maximum-likelihood lambda
+    template <typename T>
+    std::vector<T> boxCoxTransform(const std::vector<T> &data)
+    {
+        return boxCoxTransform(data, fitBoxCoxLambda(data));
+    }
+};
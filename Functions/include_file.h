@@ -17,5 +17,21 @@
 #include "random"
 #include "limits"
 #include "stdexcept"
+#include "cstdint"
+#include "string"
+#include "string_view"
+#include "thread"
+#include "optional"
+#include "queue"
+#include "atomic"
+#include "mutex"
+#include "cstring"
+#include "type_traits"
+#include "memory"
+#include "memory_resource"
+#include "fstream"
+#include "cstdio"
+#include "charconv"
+#include "exception"
 
 #endif
\ No newline at end of file
@@ -3,7 +3,15 @@
 #include "iostream"
 #include "fstream"
 #include "vector"
+#include "filesystem"
 #include "opencv2/opencv.hpp"
+#include "PCA.h"
+
+// The MLP is trained on this many principal components of the pixels
+// instead of all 784 (0 = raw pixels). The projection is saved next to the
+// model and applied again before predicting.
+const size_t pcaComponents = 64;
+const std::string pcaPath = "mnist_pca.bin";
 
 // 28 * 28
 std::vector<std::vector<unsigned char>> readImages(const std::string &filename)
@@ -147,6 +155,22 @@ void load_data_train_model_save()
     ann->setActivationFunction(cv::ml::ANN_MLP::SIGMOID_SYM, 1, 1);
 
     int inputLayersSize = imagesData[0].total();
+
+    // Randomized PCA straight on the uint8 pixels; whitened codes have unit
+    // variance, which suits the symmetric sigmoid
+    std::vector<std::vector<float>> codes;
+    if (pcaComponents > 0)
+    {
+        PCA<float> pca(pcaComponents, true);
+        pca.fit(images);
+        const std::vector<double> ratio = pca.getExplainedVarianceRatio();
+        std::cout << "PCA: " << pcaComponents << " components keep " << std::accumulate(ratio.begin(), ratio.end(), 0.0) * 100.0
+                  << "% of the pixel variance" << std::endl;
+        codes = pca.transform(images);
+        save_object(pca, pcaPath);
+        inputLayersSize = static_cast<int>(pcaComponents);
+    }
+
     int hiddenLayers = 100;
     int outputLayerSize = 10;
 
@@ -161,8 +185,15 @@ void load_data_train_model_save()
 
     for (int i = 0; i < numberOfSamples; i++)
     {
-        cv::Mat image = imagesData[i].reshape(1, 1);
-        image.convertTo(trainingData.row(i), CV_32F);
+        if (pcaComponents > 0)
+        {
+            std::copy(codes[i].begin(), codes[i].end(), trainingData.ptr<float>(i));
+        }
+        else
+        {
+            cv::Mat image = imagesData[i].reshape(1, 1);
+            image.convertTo(trainingData.row(i), CV_32F);
+        }
 
         cv::Mat label = cv::Mat::zeros(1, outputLayerSize, CV_32F);
         label.at<float>((int)labelsData[i]) = 1.0f;
@@ -188,6 +219,17 @@ void load_model_predict_test_image()
 {
     cv::Ptr<cv::ml::ANN_MLP> loadedModel = cv::ml::ANN_MLP::load("mnist_trained_model.xml");
 
+    // models trained on PCA codes come with their projection
+    std::optional<PCA<float>> pca;
+    if (std::filesystem::exists(pcaPath))
+    {
+        pca = load_object<PCA<float>>(pcaPath);
+        if (loadedModel->getLayerSizes().at<int>(0) != static_cast<int>(pca->getNumComponents()))
+        {
+            pca.reset(); // the model was trained on raw pixels
+        }
+    }
+
     std::string testImageFolderPath = "/Users/anshumantiwari/Documents/CODES/ALGO & ML/C++/ML/MNIST/test_images";
 
     // iterate all the image file in this folder
@@ -207,6 +249,12 @@ void load_model_predict_test_image()
         cv::Mat input;
 
         testImageFlatten.convertTo(input, CV_32F);
+        if (pca)
+        {
+            cv::Mat projected(1, static_cast<int>(pca->getNumComponents()), CV_32F);
+            pca->transform(input.ptr<float>(0), 1, projected.ptr<float>(0));
+            input = projected;
+        }
 
         // perform the prediction using the loaded model
         cv::Mat output;
@@ -1 +1 @@
-g++ -std=c++17 -o main main.cpp -I/opt/homebrew/Cellar/opencv/4.9.0_3/include/opencv4 -L/opt/homebrew/Cellar/opencv/4.9.0_3/lib -lopencv_core -lopencv_highgui -lopencv_imgproc -lopencv_imgcodecs -lopencv_ml && ./main && rm -rf ./main
+g++ -std=c++17 -O2 -pthread -o main main.cpp -I../Functions -I/opt/homebrew/Cellar/opencv/4.9.0_3/include/opencv4 -L/opt/homebrew/Cellar/opencv/4.9.0_3/lib -lopencv_core -lopencv_highgui -lopencv_imgproc -lopencv_imgcodecs -lopencv_ml && ./main && rm -rf ./main
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "include_file.h"
+#include "functional"
+#include "cstdlib"
+
+// Minimal micro-benchmark harness for the Functions/ library.
+//
+// Each case registers a setup function: given n elements it builds its
+// inputs (untimed) and returns the operation to time, which receives the
+// thread count. The runner sweeps n over powers of ten and, for threaded
+// cases, over the requested thread counts, and reports per call:
+//   ns/element  best time over the repetitions divided by n
+//   GB/s        bytesPerElement * n / best time (bytes read + written)
+//   allocs      heap allocations per call (operator new is counted)
+//   alloc MB    bytes requested from the heap per call
+// Cases whose inputs would not fit in memory at the top of the sweep set
+// maxElements.
+struct BenchmarkCase
+{
+    std::string name;
+    bool threaded = false;
+    double bytesPerElement = 0.0;
+    size_t maxElements = std::numeric_limits<size_t>::max();
+    std::function<std::function<void(size_t)>(size_t)> setup;
+};
+
+std::vector<BenchmarkCase> &benchmark_registry();
+
+// Allocation counters maintained by the replaced operator new
+struct AllocationCount
+{
+    uint64_t calls;
+    uint64_t bytes;
+};
+
+AllocationCount allocation_count();
+
+struct RegisterBenchmark
+{
+    explicit RegisterBenchmark(BenchmarkCase benchmark)
+    {
+        benchmark_registry().push_back(std::move(benchmark));
+    }
+};
+
+// Keeps the optimiser from discarding a result
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Deterministic inputs shared by the suites
+inline std::vector<double> random_values(size_t n, uint64_t seed = 42, double low = 0.0, double high = 1.0)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> distribution(low, high);
+    std::vector<double> values(n);
+    for (double &value : values)
+    {
+        value = distribution(rng);
+    }
+    return values;
+}
+
+inline std::vector<float> random_floats(size_t n, uint64_t seed = 42, double low = 0.0, double high = 1.0)
+{
+    const std::vector<double> values = random_values(n, seed, low, high);
+    return std::vector<float>(values.begin(), values.end());
+}
+
+// n labels drawn from a vocabulary of distinct labels
+inline std::vector<std::string> random_labels(size_t n, size_t distinct, uint64_t seed = 42)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<std::string> labels(n);
+    for (std::string &label : labels)
+    {
+        label = "category_" + std::to_string(rng() % distinct);
+    }
+    return labels;
+}
@@ -0,0 +1,31 @@
+#include "Benchmark.h"
+#include "EncodeNumericFeatures.h"
+
+namespace
+{
+RegisterBenchmark uniformFit({"uniform_binning/fit<double>", true, 8.0, std::numeric_limits<size_t>::max(),
+                              [](size_t n) -> std::function<void(size_t)>
+                              {
+                                  return [data = random_values(n)](size_t threads)
+                                  { do_not_optimize(UniformBinning<double>(data, 16, threads)); };
+                              }});
+
+RegisterBenchmark uniformCut({"uniform_binning/cut<double>", false, 9.0, std::numeric_limits<size_t>::max(),
+                              [](size_t n) -> std::function<void(size_t)>
+                              {
+                                  std::vector<double> data = random_values(n);
+                                  UniformBinning<double> binning(data, 16, 1);
+                                  return [data = std::move(data), codes = std::vector<uint8_t>(n), binning](size_t) mutable
+                                  { binning.cut(data.data(), data.size(), codes.data()); };
+                              }});
+
+// uneven edges: searched, not computed
+RegisterBenchmark kmeansCut({"kmeans_binning/cut<double>", false, 9.0, std::numeric_limits<size_t>::max(),
+                             [](size_t n) -> std::function<void(size_t)>
+                             {
+                                 std::vector<double> data = random_values(n);
+                                 KMeansBinning<double> binning(data, 32, 0, 10000);
+                                 return [data = std::move(data), codes = std::vector<uint8_t>(n), binning](size_t) mutable
+                                 { binning.cut(data.data(), data.size(), codes.data()); };
+                             }});
+} // namespace
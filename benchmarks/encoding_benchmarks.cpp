@@ -0,0 +1,43 @@
+#include "Benchmark.h"
+#include "Encoding.h"
+#include "HashingVectorizer.h"
+
+namespace
+{
+// std::string inputs: capped at 1e7 elements to stay within memory
+constexpr size_t maxLabels = 10000000;
+
+RegisterBenchmark labelEncode({"label_encoder/encode", false, 32.0 + 4.0, maxLabels,
+                               [](size_t n) -> std::function<void(size_t)>
+                               {
+                                   std::vector<std::string> labels = random_labels(n, 1000);
+                                   LabelEncoder<std::string> encoder;
+                                   encoder.fit(labels);
+                                   return [labels = std::move(labels), codes = std::vector<int>(n), encoder](size_t) mutable
+                                   { encoder.encode(labels.data(), labels.size(), codes.data()); };
+                               }});
+
+RegisterBenchmark oneHotEncode({"one_hot_encoder/encode", false, 32.0 + 12.0, maxLabels,
+                                [](size_t n) -> std::function<void(size_t)>
+                                {
+                                    std::vector<std::string> labels = random_labels(n, 1000);
+                                    OneHotEncoder<std::string> encoder;
+                                    encoder.fit(labels);
+                                    return [labels = std::move(labels), encoder](size_t)
+                                    { do_not_optimize(encoder.encode(labels)); };
+                                }});
+
+// bags of 16 tokens; one element = one token
+RegisterBenchmark hashing({"hashing_vectorizer/transform", true, 32.0 + 12.0, maxLabels,
+                           [](size_t n) -> std::function<void(size_t)>
+                           {
+                               const std::vector<std::string> tokens = random_labels(n, 100000);
+                               std::vector<std::vector<std::string>> rows(std::max<size_t>(1, n / 16));
+                               for (size_t i = 0; i < tokens.size(); ++i)
+                               {
+                                   rows[std::min(i / 16, rows.size() - 1)].push_back(tokens[i]);
+                               }
+                               return [rows = std::move(rows), vectorizer = HashingVectorizer()](size_t threads)
+                               { do_not_optimize(vectorizer.transform(rows, threads)); };
+                           }});
+} // namespace
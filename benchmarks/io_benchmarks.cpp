@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+#include "ColumnTable.h"
+#include "CsvReader.h"
+#include "sstream"
+
+namespace
+{
+RegisterBenchmark columnWrite({"column_table/write<float>", false, 4.0, size_t(10000000),
+                               [](size_t n) -> std::function<void(size_t)>
+                               {
+                                   return [data = random_floats(n)](size_t)
+                                   {
+                                       ColumnTableWriter writer("column_table_benchmark.mlct");
+                                       writer.addColumn("value", data);
+                                       writer.finish();
+                                       std::remove("column_table_benchmark.mlct");
+                                   };
+                               }});
+
+// Open (directory only) and sum one mapped column; the file is unlinked
+// after mapping, so the pages come from the page cache
+RegisterBenchmark columnScan({"column_table/open_scan<float>", false, 4.0, size_t(100000000),
+                              [](size_t n) -> std::function<void(size_t)>
+                              {
+                                  {
+                                      ColumnTableWriter writer("column_table_benchmark.mlct");
+                                      writer.addColumn("value", random_floats(n));
+                                      writer.finish();
+                                  }
+                                  std::shared_ptr<const MappedFile> file = MappedFile::open("column_table_benchmark.mlct");
+                                  std::remove("column_table_benchmark.mlct");
+                                  return [file](size_t)
+                                  {
+                                      const ColumnTable table = ColumnTable::load(file);
+                                      const FlatArray<float> values = table.column<float>(0);
+                                      do_not_optimize(std::accumulate(values.begin(), values.end(), 0.0f));
+                                  };
+                              }});
+
+// Range filter that reads only the chunks whose min/max overlap (sorted
+// values: 1% of the chunks)
+RegisterBenchmark columnSkip({"column_table/filtered_scan<double>", false, 8.0, size_t(100000000),
+                              [](size_t n) -> std::function<void(size_t)>
+                              {
+                                  {
+                                      std::vector<double> sorted = random_values(n);
+                                      std::sort(sorted.begin(), sorted.end());
+                                      ColumnTableWriter writer("column_table_benchmark.mlct", 4096);
+                                      writer.addColumn("value", sorted);
+                                      writer.finish();
+                                  }
+                                  const ColumnTable table = ColumnTable::open("column_table_benchmark.mlct");
+                                  std::remove("column_table_benchmark.mlct");
+                                  return [table](size_t)
+                                  {
+                                      double sum = 0.0;
+                                      for (size_t c = 0; c < table.numChunks(); ++c)
+                                      {
+                                          if (table.chunkMayContain(0, c, 0.5, 0.51))
+                                          {
+                                              for (double value : table.chunk<double>(0, c))
+                                              {
+                                                  sum += value >= 0.5 && value <= 0.51 ? value : 0.0;
+                                              }
+                                          }
+                                      }
+                                      do_not_optimize(sum);
+                                  };
+                              }});
+
+// n values in [0, 1) with 6 decimals, 8 per line: 9 bytes per value
+std::string csv_text(size_t n)
+{
+    const std::vector<double> values = random_values(n);
+    std::string text = "c0,c1,c2,c3,c4,c5,c6,c7\n";
+    char field[16];
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        std::snprintf(field, sizeof(field), "%.6f", values[i]);
+        text += field;
+        text += i % 8 == 7 || i + 1 == values.size() ? '\n' : ',';
+    }
+    return text;
+}
+
+RegisterBenchmark csvParse({"csv_reader/parse<double>", true, 9.0, size_t(100000000),
+                            [](size_t n) -> std::function<void(size_t)>
+                            {
+                                return [text = csv_text(n)](size_t threads)
+                                { do_not_optimize(CsvReader<double>(',', true, threads).parse(text)); };
+                            }});
+
+// The std::getline / std::stod loader CsvReader replaces
+RegisterBenchmark csvGetline({"csv_reader/getline_stod<double>", false, 9.0, size_t(10000000),
+                              [](size_t n) -> std::function<void(size_t)>
+                              {
+                                  return [text = csv_text(n)](size_t)
+                                  {
+                                      std::istringstream stream(text);
+                                      std::vector<std::vector<double>> columns(8);
+                                      std::string line;
+                                      std::getline(stream, line);
+                                      while (std::getline(stream, line))
+                                      {
+                                          std::istringstream fields(line);
+                                          std::string field;
+                                          for (size_t c = 0; std::getline(fields, field, ','); ++c)
+                                          {
+                                              columns[c].push_back(std::stod(field));
+                                          }
+                                      }
+                                      do_not_optimize(columns);
+                                  };
+                              }});
+} // namespace
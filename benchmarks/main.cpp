@@ -0,0 +1,248 @@
+// Benchmark runner: ml_functions_benchmark [--min-size N] [--max-size N]
+//   [--threads 1,2,8] [--filter substring] [--min-time seconds] [--csv]
+//   [--metrics]
+// Sizes accept scientific notation (--max-size 1e6). --metrics prints the
+// library's operation counters (Prometheus text format) after the run.
+
+#include "Benchmark.h"
+#include "Metrics.h"
+#include "chrono"
+#include "iomanip"
+#include "new"
+#include "sstream"
+
+namespace
+{
+std::atomic<uint64_t> allocationCalls{0};
+std::atomic<uint64_t> allocationBytes{0};
+
+void *counted_allocation(size_t size)
+{
+    allocationCalls.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    metrics_count_allocation(size);
+    if (void *pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *counted_aligned_allocation(size_t size, std::align_val_t alignment)
+{
+    allocationCalls.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    metrics_count_allocation(size);
+    const size_t align = static_cast<size_t>(alignment);
+    if (void *pointer = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+struct Options
+{
+    size_t minSize = 1000;
+    size_t maxSize = 100000000;
+    std::vector<size_t> threads;
+    std::string filter;
+    double minTime = 0.2;
+    bool csv = false;
+    bool metrics = false;
+};
+
+Options parse_options(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        auto value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("Missing value for " + argument);
+            }
+            return argv[++i];
+        };
+        if (argument == "--min-size")
+        {
+            // sizes grow by n *= 10, so 0 would never reach --max-size
+            const double size = std::stod(value());
+            if (!(size >= 1.0))
+            {
+                throw std::invalid_argument("--min-size must be at least 1");
+            }
+            options.minSize = static_cast<size_t>(size);
+        }
+        else if (argument == "--max-size")
+        {
+            options.maxSize = static_cast<size_t>(std::stod(value()));
+        }
+        else if (argument == "--threads")
+        {
+            std::stringstream list(value());
+            for (std::string item; std::getline(list, item, ',');)
+            {
+                options.threads.push_back(std::stoul(item));
+            }
+        }
+        else if (argument == "--filter")
+        {
+            options.filter = value();
+        }
+        else if (argument == "--min-time")
+        {
+            options.minTime = std::stod(value());
+        }
+        else if (argument == "--csv")
+        {
+            options.csv = true;
+        }
+        else if (argument == "--metrics")
+        {
+            options.metrics = true;
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option " + argument);
+        }
+    }
+    if (options.threads.empty())
+    {
+        const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        options.threads = hardware > 1 ? std::vector<size_t>{1, hardware} : std::vector<size_t>{1};
+    }
+    return options;
+}
+
+struct Measurement
+{
+    double seconds;
+    double allocations;
+    double allocatedBytes;
+};
+
+// Best time over repetitions of at least minTime in total (one warm-up call first)
+Measurement measure(const std::function<void(size_t)> &operation, size_t threads, double minTime)
+{
+    using Clock = std::chrono::steady_clock;
+    operation(threads);
+
+    const AllocationCount before = allocation_count();
+    double best = std::numeric_limits<double>::infinity();
+    double total = 0.0;
+    size_t repetitions = 0;
+    while (repetitions < 3 || total < minTime)
+    {
+        const Clock::time_point start = Clock::now();
+        operation(threads);
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        best = std::min(best, elapsed);
+        total += elapsed;
+        ++repetitions;
+        if (repetitions >= 3 && elapsed > minTime)
+        {
+            break;
+        }
+    }
+    const AllocationCount after = allocation_count();
+    return Measurement{best, static_cast<double>(after.calls - before.calls) / repetitions,
+                       static_cast<double>(after.bytes - before.bytes) / repetitions};
+}
+} // namespace
+
+void *operator new(size_t size) { return counted_allocation(size); }
+void *operator new[](size_t size) { return counted_allocation(size); }
+void *operator new(size_t size, std::align_val_t alignment) { return counted_aligned_allocation(size, alignment); }
+void *operator new[](size_t size, std::align_val_t alignment) { return counted_aligned_allocation(size, alignment); }
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+std::vector<BenchmarkCase> &benchmark_registry()
+{
+    static std::vector<BenchmarkCase> registry;
+    return registry;
+}
+
+AllocationCount allocation_count()
+{
+    return AllocationCount{allocationCalls.load(), allocationBytes.load()};
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = parse_options(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchmarkCase> cases = benchmark_registry();
+    std::sort(cases.begin(), cases.end(), [](const BenchmarkCase &a, const BenchmarkCase &b)
+              { return a.name < b.name; });
+
+    if (options.csv)
+    {
+        std::cout << "name,elements,threads,ns_per_element,gb_per_s,allocations,alloc_bytes" << std::endl;
+    }
+    else
+    {
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "elements"
+                  << std::setw(8) << "threads" << std::setw(14) << "ns/element" << std::setw(10) << "GB/s"
+                  << std::setw(12) << "allocs" << std::setw(12) << "alloc MB" << std::endl;
+    }
+
+    for (const BenchmarkCase &benchmark : cases)
+    {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+        for (size_t n = options.minSize; n <= std::min(options.maxSize, benchmark.maxElements); n *= 10)
+        {
+            const std::function<void(size_t)> operation = benchmark.setup(n);
+            const std::vector<size_t> threadCounts = benchmark.threaded ? options.threads : std::vector<size_t>{1};
+            for (size_t threads : threadCounts)
+            {
+                const Measurement result = measure(operation, threads, options.minTime);
+                const double nsPerElement = result.seconds * 1e9 / n;
+                const double gbPerSecond = benchmark.bytesPerElement * n / result.seconds / 1e9;
+                if (options.csv)
+                {
+                    std::cout << benchmark.name << "," << n << "," << threads << "," << nsPerElement << ","
+                              << gbPerSecond << "," << result.allocations << "," << result.allocatedBytes << std::endl;
+                }
+                else
+                {
+                    std::cout << std::left << std::setw(40) << benchmark.name << std::right << std::setw(12) << n
+                              << std::setw(8) << threads << std::fixed << std::setprecision(3) << std::setw(14)
+                              << nsPerElement << std::setprecision(2) << std::setw(10) << gbPerSecond
+                              << std::setprecision(1) << std::setw(12) << result.allocations << std::setw(12)
+                              << result.allocatedBytes / 1e6 << std::defaultfloat << std::endl;
+                }
+            }
+            if (n > std::numeric_limits<size_t>::max() / 10)
+            {
+                break;
+            }
+        }
+    }
+    if (options.metrics)
+    {
+        std::cout << MetricsRegistry::global().exposition();
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include "Benchmark.h"
+#include "DataImputer.h"
+#include "FeatureScaling.h"
+#include "Normalisation.h"
+
+namespace
+{
+RegisterBenchmark minMaxDouble({"normalisation/min_max<double>", false, 16.0, std::numeric_limits<size_t>::max(),
+                                [](size_t n) -> std::function<void(size_t)>
+                                {
+                                    return [data = random_values(n)](size_t)
+                                    { do_not_optimize(min_max_normalisation(data)); };
+                                }});
+
+RegisterBenchmark minMaxFloat({"normalisation/min_max<float>", false, 8.0, std::numeric_limits<size_t>::max(),
+                               [](size_t n) -> std::function<void(size_t)>
+                               {
+                                   return [data = random_floats(n)](size_t)
+                                   { do_not_optimize(min_max_normalisation(data)); };
+                               }});
+
+RegisterBenchmark standardiseDouble({"normalisation/standardisation<double>", false, 16.0, std::numeric_limits<size_t>::max(),
+                                     [](size_t n) -> std::function<void(size_t)>
+                                     {
+                                         return [data = random_values(n)](size_t)
+                                         { do_not_optimize(standardisation(data)); };
+                                     }});
+
+RegisterBenchmark standardiseFloat({"normalisation/standardisation<float>", false, 8.0, std::numeric_limits<size_t>::max(),
+                                    [](size_t n) -> std::function<void(size_t)>
+                                    {
+                                        return [data = random_floats(n)](size_t)
+                                        { do_not_optimize(standardisation(data)); };
+                                    }});
+
+// n values as rows of the given width
+std::vector<std::vector<float>> float_rows(size_t n, size_t columns)
+{
+    const std::vector<float> values = random_floats(n);
+    std::vector<std::vector<float>> rows(std::max<size_t>(1, n / columns));
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        const size_t first = std::min(i * columns, values.size());
+        rows[i].assign(values.begin() + first, values.begin() + std::min(first + columns, values.size()));
+        rows[i].resize(columns, 0.0f);
+    }
+    return rows;
+}
+
+// 16 columns per row
+RegisterBenchmark featureScaler({"feature_scaler/transform<float>", false, 8.0, size_t(100000000),
+                                 [](size_t n) -> std::function<void(size_t)>
+                                 {
+                                     std::vector<std::vector<float>> rows = float_rows(n, 16);
+                                     FeatureScaler<float> scaler;
+                                     scaler.fit(rows);
+                                     return [rows = std::move(rows), scaler](size_t) mutable
+                                     { do_not_optimize(scaler.transform(rows)); };
+                                 }});
+
+// Same rows, output rows allocated from an arena that is reset after each batch
+RegisterBenchmark featureScalerArena({"feature_scaler/transform<float>/arena", false, 8.0, size_t(100000000),
+                                      [](size_t n) -> std::function<void(size_t)>
+                                      {
+                                          std::vector<std::vector<float>> rows = float_rows(n, 16);
+                                          FeatureScaler<float> scaler;
+                                          scaler.fit(rows);
+                                          return [rows = std::move(rows), scaler, arena = std::make_shared<BumpArena>()](size_t) mutable
+                                          {
+                                              do_not_optimize(scaler.transform(rows, arena.get()));
+                                              arena->reset();
+                                          };
+                                      }});
+
+// 8 columns, 5% missing
+RegisterBenchmark imputerMean({"simple_imputer/transform_mean<double>", false, 16.0, size_t(100000000),
+                               [](size_t n) -> std::function<void(size_t)>
+                               {
+                                   const std::vector<double> values = random_values(n);
+                                   std::vector<std::vector<double>> rows(std::max<size_t>(1, n / 8), std::vector<double>(8));
+                                   for (size_t i = 0; i < rows.size() * 8; ++i)
+                                   {
+                                       const double value = values[i % values.size()];
+                                       rows[i / 8][i % 8] = value < 0.05 ? std::numeric_limits<double>::quiet_NaN() : value;
+                                   }
+                                   SimpleImputer<double> imputer(rows);
+                                   imputer.fit();
+                                   return [rows = std::move(rows), imputer](size_t) mutable
+                                   { do_not_optimize(imputer.transform(rows, "mean")); };
+                               }});
+
+// Cost of one instrumented call: n ScopedOperation records split over the
+// threads, each thread adding to its own shard
+RegisterBenchmark scopedOperation({"metrics/scoped_operation", true, 0.0, size_t(10000000),
+                                   [](size_t n) -> std::function<void(size_t)>
+                                   {
+                                       return [n](size_t threads)
+                                       {
+                                           OperationMetrics &metrics = MetricsRegistry::global().operation("benchmark.scoped_operation");
+                                           parallel_for(
+                                               n,
+                                               [&](size_t begin, size_t end, size_t)
+                                               {
+                                                   for (size_t i = begin; i < end; ++i)
+                                                   {
+                                                       const ScopedOperation timing(metrics, 1, 8);
+                                                   }
+                                               },
+                                               threads, 1 << 12);
+                                       };
+                                   }});
+} // namespace
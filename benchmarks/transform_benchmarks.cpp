@@ -0,0 +1,117 @@
+#include "Benchmark.h"
+#include "PCA.h"
+#include "Transformer.h"
+
+namespace
+{
+RegisterBenchmark logDouble({"transformer/log<double>", false, 16.0, std::numeric_limits<size_t>::max(),
+                             [](size_t n) -> std::function<void(size_t)>
+                             {
+                                 return [data = random_values(n, 42, 0.01, 100.0), transformer = MLTransformer()](size_t) mutable
+                                 { do_not_optimize(transformer.logTransform(data)); };
+                             }});
+
+RegisterBenchmark logFloat({"transformer/log<float>", false, 8.0, std::numeric_limits<size_t>::max(),
+                            [](size_t n) -> std::function<void(size_t)>
+                            {
+                                return [data = random_floats(n, 42, 0.01, 100.0), transformer = MLTransformer()](size_t) mutable
+                                { do_not_optimize(transformer.logTransform(data)); };
+                            }});
+
+// Result allocated from a bump arena reset after every call: no heap traffic
+RegisterBenchmark logDoubleArena({"transformer/log<double>/arena", false, 16.0, std::numeric_limits<size_t>::max(),
+                                  [](size_t n) -> std::function<void(size_t)>
+                                  {
+                                      return [data = random_values(n, 42, 0.01, 100.0), transformer = MLTransformer(),
+                                              arena = std::make_shared<BumpArena>(n * sizeof(double) + 64)](size_t) mutable
+                                      {
+                                          do_not_optimize(transformer.logTransform(data, arena.get()));
+                                          arena->reset();
+                                      };
+                                  }});
+
+RegisterBenchmark boxCox({"transformer/box_cox<double>", false, 16.0, std::numeric_limits<size_t>::max(),
+                          [](size_t n) -> std::function<void(size_t)>
+                          {
+                              return [data = random_values(n, 42, 0.01, 100.0), transformer = MLTransformer()](size_t) mutable
+                              { do_not_optimize(transformer.boxCoxTransform(data, 0.3)); };
+                          }});
+
+RegisterBenchmark powerFit({"power_transformer/fit_lambda<double>", true, 8.0, std::numeric_limits<size_t>::max(),
+                            [](size_t n) -> std::function<void(size_t)>
+                            {
+                                return [data = random_values(n, 42, 0.01, 100.0)](size_t threads)
+                                {
+                                    const PowerTransformer power(PowerMethod::YeoJohnson, 0, threads);
+                                    do_not_optimize(power.fitLambda(data.data(), data.size()));
+                                };
+                            }});
+
+RegisterBenchmark quantile({"quantile_transformer/transform<double>", true, 16.0, std::numeric_limits<size_t>::max(),
+                            [](size_t n) -> std::function<void(size_t)>
+                            {
+                                std::vector<double> data = random_values(n);
+                                QuantileTransformer<double> quantiles(1000);
+                                quantiles.fit(data.data(), std::min<size_t>(n, 100000));
+                                return [data = std::move(data), output = std::vector<double>(n), quantiles](size_t threads) mutable
+                                { quantiles.transform(data.data(), data.size(), 0, output.data(), threads); };
+                            }});
+
+// 4 input columns, degree 2: 14 output values per 4 inputs
+RegisterBenchmark polynomial({"polynomial_features/degree2<double>", true, 8.0 * (1.0 + 14.0 / 4.0), size_t(10000000),
+                              [](size_t n) -> std::function<void(size_t)>
+                              {
+                                  PolynomialFeatures<double> expander(2);
+                                  expander.fit(4);
+                                  const size_t rows = std::max<size_t>(1, n / 4);
+                                  return [data = random_values(rows * 4), output = std::vector<double>(rows * 14), expander, rows](size_t threads) mutable
+                                  { expander.transform(data.data(), rows, output.data(), threads); };
+                              }});
+
+// MNIST-shaped uint8 rows (784 pixels, ~85% zeros) with a decaying
+// spectrum: 20 random patterns, mostly clipped to 0
+std::vector<uint8_t> pixel_rows(size_t rows)
+{
+    const size_t pixels = 784, patterns = 20;
+    const std::vector<double> basis = random_values(patterns * pixels, 7, -1.0, 1.0);
+    const std::vector<double> weights = random_values(rows * patterns, 8, -1.0, 1.0);
+    std::vector<uint8_t> data(rows * pixels);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        for (size_t p = 0; p < pixels; ++p)
+        {
+            double value = 0.0;
+            for (size_t r = 0; r < patterns; ++r)
+            {
+                value += weights[i * patterns + r] * basis[r * pixels + p] / static_cast<double>(r + 1);
+            }
+            data[i * pixels + p] = static_cast<uint8_t>(std::clamp(400.0 * value - 100.0, 0.0, 255.0));
+        }
+    }
+    return data;
+}
+
+// n images (elements are rows here); k = 64 with the default 4 power
+// iterations reads the 784 pixels of every image 6 times
+RegisterBenchmark pcaFit({"pca/fit<float>/k64", true, 6.0 * 784.0, size_t(100000),
+                          [](size_t n) -> std::function<void(size_t)>
+                          {
+                              return [data = pixel_rows(n), n](size_t threads)
+                              {
+                                  PCA<float> pca(64, true, 4, 10, 0, threads);
+                                  pca.fit(data.data(), n, 784);
+                                  do_not_optimize(pca);
+                              };
+                          }});
+
+// n images: 784 uint8 pixels in, 64 float codes out
+RegisterBenchmark pcaTransform({"pca/transform<float>/k64", false, 784.0 + 4.0 * 64.0, size_t(1000000),
+                                [](size_t n) -> std::function<void(size_t)>
+                                {
+                                    std::vector<uint8_t> data = pixel_rows(std::max<size_t>(n, 64));
+                                    PCA<float> pca(64, true, 4, 10, 0, 1);
+                                    pca.fit(data.data(), std::max<size_t>(n, 64), 784);
+                                    return [data = std::move(data), codes = std::vector<float>(n * 64), pca, n](size_t) mutable
+                                    { pca.transform(data.data(), n, codes.data()); };
+                                }});
+} // namespace
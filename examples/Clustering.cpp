@@ -0,0 +1,32 @@
+#include "Clustering.h"
+
+int main()
+{
+    // two well separated blobs in 3-d
+    std::vector<std::vector<double>> points = {{1.0, 1.0, 1.0}, {1.5, 2.0, 1.0}, {1.0, 1.5, 2.0},
+                                               {8.0, 8.0, 8.0}, {9.0, 8.5, 8.0}, {8.5, 9.0, 9.5}};
+
+    KMeans<double> kmeans(2);
+    kmeans.fit(points);
+
+    std::cout << "Centroids:" << std::endl;
+    const auto &centroids = kmeans.getCentroids();
+    for (size_t c = 0; c < 2; ++c)
+    {
+        for (size_t j = 0; j < kmeans.getDimensions(); ++j)
+        {
+            std::cout << centroids[c * kmeans.getDimensions() + j] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Labels:";
+    for (uint32_t label : kmeans.getLabels())
+    {
+        std::cout << " " << label;
+    }
+    std::cout << std::endl;
+    std::cout << "Inertia: " << kmeans.getInertia() << std::endl;
+
+    return 0;
+}
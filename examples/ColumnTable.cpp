@@ -0,0 +1,83 @@
+#include "ColumnTable.h"
+
+int main()
+{
+    // 1000 rows: a pixel column with missing values, a row counter and a label
+    const size_t rows = 1000;
+    std::vector<float> pixels(rows);
+    std::vector<int> counter(rows);
+    std::vector<std::string> labels(rows);
+    const char *names[] = {"cat", "dog", "mouse"};
+    for (size_t i = 0; i < rows; ++i)
+    {
+        pixels[i] = i % 97 == 0 ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>((i * 37) % 256);
+        counter[i] = static_cast<int>(i);
+        labels[i] = names[i % 3];
+    }
+
+    {
+        ColumnTableWriter writer("features.mlct", 256);
+        writer.addColumn("pixel", pixels);
+        writer.addColumn("row", counter);
+        writer.addColumn("label", labels);
+        writer.finish();
+    }
+
+    const ColumnTable table = ColumnTable::open("features.mlct");
+    std::remove("features.mlct"); // the mapping stays readable
+    std::cout << "Rows: " << table.rows() << ", columns: " << table.numColumns() << ", chunks: " << table.numChunks() << std::endl;
+
+    const size_t pixel = table.columnIndex("pixel");
+    for (size_t c = 0; c < table.numChunks(); ++c)
+    {
+        const ColumnChunkStats &stats = table.chunkStats(pixel, c);
+        std::cout << "pixel chunk " << c << ": rows " << stats.rows << ", nulls " << stats.nullCount << ", min " << stats.min
+                  << ", max " << stats.max << std::endl;
+    }
+
+    // min-max scaling straight from the directory, no pass over the values
+    const ColumnChunkStats pixelStats = table.columnStats(pixel);
+    const FlatArray<float> values = table.column<float>(pixel);
+    std::cout << "Scaled pixels:";
+    for (size_t i = 0; i < 6; ++i)
+    {
+        std::cout << " " << (values[i] - pixelStats.min) / (pixelStats.max - pixelStats.min);
+    }
+    std::cout << std::endl;
+
+    // only chunks whose range overlaps [600, 700] are read
+    const size_t row = table.columnIndex("row");
+    long long sum = 0;
+    size_t chunksRead = 0;
+    for (size_t c = 0; c < table.numChunks(); ++c)
+    {
+        if (!table.chunkMayContain(row, c, 600, 700))
+        {
+            continue;
+        }
+        ++chunksRead;
+        for (int value : table.chunk<int>(row, c))
+        {
+            sum += value >= 600 && value <= 700 ? value : 0;
+        }
+    }
+    std::cout << "Sum of rows 600..700: " << sum << " (" << chunksRead << " chunks read)" << std::endl;
+
+    // strings are stored once, rows hold uint32 codes
+    const size_t label = table.columnIndex("label");
+    const StringDictionary &dictionary = table.dictionary(label);
+    std::cout << "Label dictionary:";
+    for (uint32_t code = 0; code < dictionary.size(); ++code)
+    {
+        std::cout << " " << code << "=" << dictionary.at(code);
+    }
+    std::cout << std::endl;
+    std::cout << "First labels:";
+    for (size_t i = 0; i < 5; ++i)
+    {
+        std::cout << " " << table.stringAt(label, i);
+    }
+    std::cout << std::endl;
+
+    return 0;
+}
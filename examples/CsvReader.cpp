@@ -0,0 +1,62 @@
+#include "CsvReader.h"
+#include "DataImputer.h"
+#include "Encoding.h"
+#include "FeatureScaling.h"
+
+int main()
+{
+    // quoted fields (with delimiters and line breaks), CRLF and empty values
+    {
+        std::ofstream file("houses.csv", std::ios::binary);
+        file << "area,rooms,city,price\r\n"
+             << "70.5,3,\"Lyon\",250000\r\n"
+             << "120,,\"Paris, 15e\",910000\r\n"
+             << "45.25,2,Lyon,\r\n"
+             << "88,4,\"Saint-\nEtienne\",185000\r\n";
+    }
+
+    const CsvColumns<double> table = CsvReader<double>().setStringColumns({"city"}).read("houses.csv");
+    std::remove("houses.csv");
+
+    std::cout << "Rows: " << table.rows() << ", columns:";
+    for (const std::string &name : table.columnNames())
+    {
+        std::cout << " " << name;
+    }
+    std::cout << std::endl;
+
+    std::cout << "rooms:";
+    for (double value : table.column("rooms"))
+    {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+
+    // empty fields arrive as NaN, ready for the imputer
+    SimpleImputer imputer(table.toRows());
+    imputer.fit();
+    const std::vector<std::vector<double>> imputed = imputer.transform("mean");
+
+    FeatureScaler scaler;
+    scaler.fit(imputed);
+    std::cout << "Imputed and scaled:" << std::endl;
+    for (const auto &row : scaler.transform(imputed))
+    {
+        for (double value : row)
+        {
+            std::cout << value << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    LabelEncoder<std::string> encoder;
+    encoder.fit(table.stringColumn("city"));
+    std::cout << "city codes:";
+    for (int code : encoder.encode(table.stringColumn("city")))
+    {
+        std::cout << " " << code;
+    }
+    std::cout << std::endl;
+
+    return 0;
+}
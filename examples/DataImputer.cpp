@@ -0,0 +1,102 @@
+#include "DataImputer.h"
+
+int main()
+{
+    std::vector<std::vector<double>> input_data = {{7, 4, 3}, {4, NAN, 6}, {10, 5, 5}, {8, 4, NAN}};
+
+    SimpleImputer imputer(input_data);
+    imputer.fit();
+
+    std::vector<std::vector<double>> transformed_data = imputer.transform("mean");
+
+    for (const auto &row : transformed_data)
+    {
+        for (const auto &val : row)
+        {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    // MOST FREQUENT
+    std::vector<std::vector<double>> transformed_data2 = imputer.transform("most_frequent");
+
+    for (const auto &row : transformed_data2)
+    {
+        for (const auto &val : row)
+        {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    // STREAMING MEDIAN (sharded across threads, merged sketches)
+    SimpleImputer streaming_imputer(input_data);
+    streaming_imputer.fit_streaming();
+
+    std::vector<std::vector<double>> transformed_data3 = streaming_imputer.transform("median");
+
+    for (const auto &row : transformed_data3)
+    {
+        for (const auto &val : row)
+        {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    // MISSING INDICATOR
+    const ValidityMask &indicator = imputer.missing_indicator();
+    for (const auto &row : indicator.toDense())
+    {
+        for (const auto &val : row)
+        {
+            std::cout << (int)val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    // FLOAT32 STORAGE (double statistics, float output), saved and loaded back
+    std::vector<std::vector<float>> input_float = {{7, 4, 3}, {4, NAN, 6}, {10, 5, 5}, {8, 4, NAN}};
+    SimpleImputer float_imputer(input_float);
+    float_imputer.fit();
+    save_object(float_imputer, "imputer.bin");
+    const auto loaded_imputer = load_object<SimpleImputer<float>>("imputer.bin");
+    std::remove("imputer.bin");
+
+    for (const auto &row : loaded_imputer.fillMissing(input_float, loaded_imputer.missing_indicator(input_float), "median"))
+    {
+        for (const auto &val : row)
+        {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    // KNN
+    KNNImputer knn_imputer(2);
+    knn_imputer.fit(input_data);
+
+    std::vector<std::vector<double>> transformed_data4 = knn_imputer.transform(input_data);
+
+    for (const auto &row : transformed_data4)
+    {
+        for (const auto &val : row)
+        {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "EncodeNumericFeatures.h"
+
+void perform_uniform_binning()
+{
+    try
+    {
+        std::vector<double> data = {43.0, 44.0, 15.0, 30.0, 35.0, 2.0, 18.0, 1.0, 19.0, 36.0};
+        size_t numBins = 3;
+
+        UniformBinning<double> binning(data, numBins);
+
+        // Print bin edges
+        std::cout << "Bin Edges: ";
+        for (const auto &edge : binning.getBinEdges())
+        {
+            std::cout << edge << " ";
+        }
+        std::cout << std::endl;
+
+        // Print bin counts
+        // Print bin counts
+        for (size_t i = 0; i < numBins; ++i)
+        { // Change here
+            try
+            {
+                std::cout << "Bin " << i << " count: " << binning.getBinCount(i) << std::endl;
+            }
+            catch (const std::out_of_range &oor)
+            {
+                std::cerr << "Out of Range error: " << oor.what() << " for Bin " << i << std::endl;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return;
+    }
+}
+
+void perform_quantile()
+{
+    std::vector<double> data = {43.0, 44.0, 15.0, 30.0, 35.0, 2.0, 18.0, 1.0, 19.0, 36.0};
+    size_t numBins = 3;
+
+    try
+    {
+
+        QuantileBinning<double> binning(data, numBins);
+
+        // Print bin edges
+        std::cout << "Bin Edges: ";
+        for (const auto &edge : binning.getBinEdges())
+        {
+            std::cout << edge << " ";
+        }
+        std::cout << std::endl;
+
+        // Print bin counts
+        for (size_t i = 0; i < numBins; ++i)
+        {
+            try
+            {
+                std::cout << "Bin " << i << " count: " << binning.getBinCount(i) << std::endl;
+            }
+            catch (const std::out_of_range &oor)
+            {
+                std::cerr << "Out of Range error: " << oor.what() << " for Bin " << i << std::endl;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return;
+    }
+};
+
+void perform_streaming_quantile()
+{
+    try
+    {
+        // two shards, e.g. two files or two workers, merged at the end
+        std::vector<double> shard1 = {43.0, 44.0, 15.0, 30.0, 35.0};
+        std::vector<double> shard2 = {2.0, 18.0, 1.0, 19.0, 36.0};
+        size_t numBins = 3;
+
+        StreamingQuantileBinning<double> binning(numBins);
+        StreamingQuantileBinning<double> other(numBins);
+        binning.update(shard1);
+        other.update(shard2);
+        binning.merge(other);
+
+        std::cout << "Bin Edges: ";
+        for (const auto &edge : binning.getBinEdges())
+        {
+            std::cout << edge << " ";
+        }
+        std::cout << std::endl;
+
+        for (size_t i = 0; i < numBins; ++i)
+        {
+            std::cout << "Bin " << i << " count: " << binning.getBinCount(i) << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+void perform_kmeans()
+{
+    std::vector<double> data = {43.0, 44.0, 15.0, 30.0, 35.0, 2.0, 18.0, 1.0, 19.0, 36.0};
+    size_t numBins = 5;
+
+    try
+    {
+        KMeansBinning<double> binning(data, numBins);
+
+        // Print bin edges
+        std::cout << "Bin Edges: ";
+        for (const auto &edge : binning.getBinEdges())
+        {
+            std::cout << edge << " ";
+        }
+        std::cout << std::endl;
+
+        std::cout << "Centroids: ";
+        for (const auto &centroid : binning.getCentroids())
+        {
+            std::cout << centroid << " ";
+        }
+        std::cout << std::endl;
+
+        std::cout << "Cut: ";
+        for (const auto &bin_index : binning.cut(data))
+        {
+            std::cout << bin_index << " ";
+        }
+        std::cout << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+void perform_decision_tree_binning()
+{
+    try
+    {
+        std::vector<double> data = {43.0, 44.0, 15.0, 30.0, 35.0, 2.0, 18.0, 1.0, 19.0, 36.0};
+        std::vector<double> target = {1.0, 1.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0};
+        size_t maxBins = 3;
+
+        DecisionTreeBinning<double> binning(data, target, maxBins);
+
+        std::cout << "Bin Edges: ";
+        for (const auto &edge : binning.getBinEdges())
+        {
+            std::cout << edge << " ";
+        }
+        std::cout << std::endl;
+
+        for (size_t i = 0; i < binning.getNumBins(); ++i)
+        {
+            std::cout << "Bin " << i << " count: " << binning.getBinCount(i) << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+// Fitted binnings saved into one buffer and mapped back, edges must match
+void perform_serialization()
+{
+    try
+    {
+        std::vector<double> data = {43.0, 44.0, 15.0, 30.0, 35.0, 2.0, 18.0, 1.0, 19.0, 36.0};
+        UniformBinning<double> uniform(data, 3);
+        QuantileBinning<double> quantile(data, 3);
+        KMeansBinning<double> kmeans(data, 3);
+
+        BinaryWriter writer;
+        uniform.save(writer);
+        quantile.save(writer);
+        kmeans.save(writer);
+        writer.writeFile("binnings.bin");
+
+        BinaryReader reader(MappedFile::open("binnings.bin"));
+        const auto loadedUniform = UniformBinning<double>::load(reader);
+        const auto loadedQuantile = QuantileBinning<double>::load(reader);
+        const auto loadedKMeans = KMeansBinning<double>::load(reader);
+        std::remove("binnings.bin");
+
+        std::cout << "Edges match after reload: " << std::boolalpha
+                  << (loadedUniform.getBinEdges() == uniform.getBinEdges() &&
+                      loadedQuantile.getBinEdges() == quantile.getBinEdges() &&
+                      loadedKMeans.getBinEdges() == kmeans.getBinEdges())
+                  << std::endl;
+        std::cout << "Cut after reload:";
+        for (size_t bin : loadedKMeans.cut(data))
+        {
+            std::cout << " " << bin;
+        }
+        std::cout << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+int main()
+{
+    std::cout << "Uniform Binning" << std::endl;
+    perform_uniform_binning();
+
+    std::cout << std::endl
+              << "K-Means Binning" << std::endl;
+    perform_kmeans();
+
+    std::cout << std::endl
+              << "Streaming Quantile Binning" << std::endl;
+    perform_streaming_quantile();
+
+    std::cout << std::endl
+              << "Decision Tree Binning" << std::endl;
+    perform_decision_tree_binning();
+
+    std::cout << std::endl
+              << "Serialization" << std::endl;
+    perform_serialization();
+}
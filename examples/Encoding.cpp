@@ -0,0 +1,130 @@
+#include "Encoding.h"
+
+int main()
+{
+    LabelEncoder<std::string> encoder;
+    std::vector<std::string> labels = {"cat", "dog", "mouse", "cat", "dog", "dog"};
+
+    encoder.fit(labels);
+
+    const auto encoded_labels = encoder.encode({"cat", "dog", "dog", "mouse"});
+    std::cout << "Encoded labels:";
+    for (int label : encoded_labels)
+    {
+        std::cout << " " << label;
+    }
+    std::cout << std::endl;
+
+    const auto decoded_labels = encoder.decode({0, 1, 1, 2});
+    std::cout << "Decoded labels:";
+    for (const auto &label : decoded_labels)
+    {
+        std::cout << " " << label;
+    }
+    std::cout << std::endl;
+
+    std::cout << "-------------------" << std::endl;
+
+    std::cout << "One hot encoding:" << std::endl;
+
+    OneHotEncoder<std::string> one_hot_encoder;
+
+    std::vector<std::string> features = {"red", "green", "blue", "red", "green", "green"};
+    one_hot_encoder.fit(features);
+
+    const auto encoded_features = one_hot_encoder.encode({"red", "green", "green", "blue"});
+
+    std::cout << "Encoded features (sparse):";
+    for (size_t i = 0; i < encoded_features.rows; ++i) {
+        std::cout << " " << encoded_features.indices[i];
+    }
+    std::cout << std::endl;
+
+    std::cout << "Encoded features:";
+    for (const auto& feature : encoded_features.toDense()) {
+        std::cout << " [";
+        for (int val : feature) {
+            std::cout << val << " ";
+        }
+        std::cout << "]";
+    }
+    std::cout << std::endl;
+
+    const auto decoded_features = one_hot_encoder.decode(encoded_features);
+    std::cout << "Decoded features:";
+    for (const auto& feature : decoded_features) {
+        std::cout << " " << feature;
+    }
+    std::cout << std::endl;
+
+    std::cout << "-------------------" << std::endl;
+
+    std::cout << "Saved and mapped back:" << std::endl;
+
+    save_object(encoder, "label_encoder.bin");
+    save_object(one_hot_encoder, "one_hot_encoder.bin");
+    const auto loaded_encoder = load_object<LabelEncoder<std::string_view>>("label_encoder.bin");
+    const auto loaded_one_hot_encoder = load_object<OneHotEncoder<std::string>>("one_hot_encoder.bin");
+    std::remove("label_encoder.bin");
+    std::remove("one_hot_encoder.bin");
+
+    std::cout << "Encoded labels:";
+    for (int label : loaded_encoder.encode({"cat", "dog", "dog", "mouse"}))
+    {
+        std::cout << " " << label;
+    }
+    std::cout << std::endl;
+    std::cout << "Decoded features:";
+    for (const auto &feature : loaded_one_hot_encoder.decode(encoded_features))
+    {
+        std::cout << " " << feature;
+    }
+    std::cout << std::endl;
+
+    std::cout << "-------------------" << std::endl;
+
+    std::cout << "Concurrent encoding:" << std::endl;
+
+    ConcurrentLabelEncoder<std::string> concurrent_encoder(UnknownPolicy::UnknownBucket);
+    concurrent_encoder.fit(labels);
+
+    // readers keep encoding while a writer grows the vocabulary
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&]()
+                             {
+                                 const std::vector<std::string> batch = {"cat", "dog", "horse", "mouse"};
+                                 while (!done.load())
+                                 {
+                                     concurrent_encoder.encode(batch);
+                                 } });
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        concurrent_encoder.fit({"animal_" + std::to_string(i), i == 50 ? "horse" : "cat"});
+    }
+    done.store(true);
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    const auto concurrent_codes = concurrent_encoder.encode({"cat", "horse", "zebra"});
+    std::cout << "Encoded labels (0 = unknown):";
+    for (int code : concurrent_codes)
+    {
+        std::cout << " " << code;
+    }
+    std::cout << std::endl;
+    std::cout << "Decoded labels:";
+    for (const auto &label : concurrent_encoder.decode(concurrent_codes))
+    {
+        std::cout << " " << label;
+    }
+    std::cout << std::endl;
+    std::cout << "Vocabulary size: " << concurrent_encoder.size() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "FeatureScaling.h"
+
+int main() {
+    // Example usage
+    std::vector<std::vector<double>> features = {{1.0, 2.0, 3.0},
+                                                 {4.0, 5.0, 6.0},
+                                                 {7.0, 8.0, 9.0}};
+
+    FeatureScaler scaler;
+    scaler.fit(features);
+    std::vector<std::vector<double>> scaledFeatures = scaler.transform(features);
+
+    // Printing scaled features
+    for (const auto& feature : scaledFeatures) {
+        for (double val : feature) {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    // float32 features (e.g. CV_32F pixels) are scaled without leaving float
+    std::vector<std::vector<float>> pixels = {{0.0f, 128.0f},
+                                              {64.0f, 192.0f},
+                                              {255.0f, 255.0f}};
+    FeatureScaler<float> pixelScaler;
+    pixelScaler.fit(pixels);
+
+    // fitted statistics survive a restart
+    save_object(pixelScaler, "pixel_scaler.bin");
+    FeatureScaler<float> loadedScaler = load_object<FeatureScaler<float>>("pixel_scaler.bin");
+    std::remove("pixel_scaler.bin");
+    for (const auto& feature : loadedScaler.transform(pixels)) {
+        for (float val : feature) {
+            std::cout << val << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
+
@@ -0,0 +1,39 @@
+#include "Normalisation.h"
+
+template <typename T>
+void print_vector(const std::vector<T> &data)
+{
+    /*
+        std::vector<double>::iterator it;
+        for (it = data.begin(); it != data.end(); it++) {
+            std::cout << *it << std::endl;
+        };
+    */
+    for (const auto &value : data)
+    {
+        std::cout << value << std::endl;
+    }
+}
+
+int main()
+{
+    std::vector<int> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    // Min-Max Normalisation
+    std::cout << "Min-Max Normalisation:" << std::endl;
+    print_vector(min_max_normalisation(data));
+
+    // Standardisation
+    std::cout << "\nStandardisation:" << std::endl;
+    print_vector(standardisation(data));
+
+    // float storage stays float (double accumulators)
+    std::vector<float> pixels = {0.0f, 32.0f, 64.0f, 128.0f, 255.0f};
+    std::cout << "\nMax-Abs Normalisation (float):" << std::endl;
+    print_vector(max_abs_normalisation(pixels));
+
+    std::cout << "\nMean Normalisation (float):" << std::endl;
+    print_vector(mean_normalisation(pixels));
+
+    return EXIT_SUCCESS;
+}
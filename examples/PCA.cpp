@@ -0,0 +1,109 @@
+#include "PCA.h"
+#include "iomanip"
+
+int main()
+{
+    // 2000 synthetic 28 x 28 "digits": one of 10 stroke patterns, shifted by
+    // up to a pixel, with noise; background pixels stay 0 as in MNIST
+    const size_t side = 28, pixels = side * side, images = 2000;
+    std::mt19937 rng(7);
+    std::vector<std::vector<double>> patterns(10, std::vector<double>(pixels, 0.0));
+    for (auto &pattern : patterns)
+    {
+        std::uniform_real_distribution<double> position(6.0, 22.0);
+        for (size_t stroke = 0; stroke < 3; ++stroke)
+        {
+            const double x0 = position(rng), y0 = position(rng), x1 = position(rng), y1 = position(rng);
+            for (double t = 0.0; t <= 1.0; t += 0.02)
+            {
+                const size_t x = static_cast<size_t>(x0 + t * (x1 - x0));
+                const size_t y = static_cast<size_t>(y0 + t * (y1 - y0));
+                pattern[y * side + x] = 255.0;
+            }
+        }
+    }
+    std::vector<uint8_t> data(images * pixels, 0);
+    std::vector<int> labels(images);
+    std::uniform_int_distribution<int> digit(0, 9), shift(-1, 1);
+    std::normal_distribution<double> noise(0.0, 20.0);
+    for (size_t i = 0; i < images; ++i)
+    {
+        labels[i] = digit(rng);
+        const int dx = shift(rng), dy = shift(rng);
+        for (size_t y = 1; y + 1 < side; ++y)
+        {
+            for (size_t x = 1; x + 1 < side; ++x)
+            {
+                const double value = patterns[labels[i]][(y + dy) * side + (x + dx)];
+                data[i * pixels + y * side + x] = value > 0.0 ? static_cast<uint8_t>(std::clamp(value + noise(rng), 0.0, 255.0)) : 0;
+            }
+        }
+    }
+
+    // fitted straight on the uint8 pixels, no float copy of the matrix
+    const size_t k = 50;
+    PCA<float> pca(k, false, 4, 10, 0, 1);
+    pca.fit(data.data(), images, pixels);
+
+    std::cout << std::fixed << std::setprecision(4);
+    const std::vector<double> ratio = pca.getExplainedVarianceRatio();
+    std::cout << "Explained variance ratio (first 5):";
+    for (size_t c = 0; c < 5; ++c)
+    {
+        std::cout << " " << ratio[c];
+    }
+    std::cout << std::endl;
+    std::cout << "Variance kept by " << k << " of " << pixels << " components: " << std::accumulate(ratio.begin(), ratio.end(), 0.0) << std::endl;
+
+    std::vector<float> codes(images * k), restored(images * pixels);
+    pca.transform(data.data(), images, codes.data());
+    pca.inverseTransform(codes.data(), images, restored.data());
+    double squaredError = 0.0;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        squaredError += (restored[i] - data[i]) * (restored[i] - data[i]);
+    }
+    std::cout << "Reconstruction RMSE (pixel units): " << std::sqrt(squaredError / static_cast<double>(data.size())) << std::endl;
+
+    // A 100-unit first layer on the codes folds back into a layer on raw
+    // pixels (same pre-activations)
+    const size_t hidden = 100;
+    std::vector<float> weights((k + 1) * hidden);
+    std::uniform_real_distribution<float> weight(-0.1f, 0.1f);
+    for (float &w : weights)
+    {
+        w = weight(rng);
+    }
+    const std::vector<float> folded = pca.foldLinearLayer(weights.data(), hidden);
+    double largestDifference = 0.0;
+    for (size_t o = 0; o < hidden; ++o)
+    {
+        double onCodes = weights[k * hidden + o], onPixels = folded[pixels * hidden + o];
+        for (size_t c = 0; c < k; ++c)
+        {
+            onCodes += codes[c] * weights[c * hidden + o];
+        }
+        for (size_t p = 0; p < pixels; ++p)
+        {
+            onPixels += data[p] * folded[p * hidden + o];
+        }
+        largestDifference = std::max(largestDifference, std::abs(onCodes - onPixels) / (1.0 + std::abs(onCodes)));
+    }
+    std::cout << "Folded layer matches within 1e-4: " << (largestDifference < 1e-4 ? "yes" : "no") << std::endl;
+    std::cout << "First-layer multiply-adds per image: " << pixels * hidden << " raw, " << k * hidden << " on codes, "
+              << pixels * k + k * hidden << " projecting at inference" << std::endl;
+
+    save_object(pca, "pca.bin");
+    const PCA<float> loaded = load_object<PCA<float>>("pca.bin");
+    std::remove("pca.bin");
+    std::vector<float> reloaded(k);
+    loaded.transform(data.data(), 1, reloaded.data());
+    double reloadDifference = 0.0;
+    for (size_t c = 0; c < k; ++c)
+    {
+        reloadDifference = std::max(reloadDifference, static_cast<double>(std::abs(reloaded[c] - codes[c])));
+    }
+    std::cout << "Reloaded codes match: " << (reloadDifference < 1e-3 ? "yes" : "no") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+#include "Transformer.h"
+
+int main()
+{
+    MLTransformer transformer;
+
+    // Example usage
+    std::vector<double> data = {1.0, 2.0, 3.0, 4.0, 5.0};
+    std::vector<std::string> categories = {"apple", "banana", "apple", "orange", "banana"};
+
+    std::vector<double> standardizedData = transformer.standardize(data);
+    std::vector<double> scaledData = transformer.minMaxScale(data, 0.0, 1.0);
+    std::vector<double> hashedData = transformer.featureHashing(categories, 5);
+    std::vector<std::vector<double>> polynomialFeatures = transformer.addPolynomialFeatures(data, 3);
+    std::vector<std::vector<double>> encodedCategories = transformer.oneHotEncodeDense(categories);
+
+    // Output transformed data
+    // (Note: In a real ML scenario, these transformed data would likely be used for further analysis or modeling)
+    // (Printing here just for demonstration purposes)
+    std::cout << "Standardized Data:";
+    for (const auto &val : standardizedData)
+    {
+        std::cout << " " << val;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Scaled Data:";
+    for (const auto &val : scaledData)
+    {
+        std::cout << " " << val;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Feature Hashed Data:";
+    for (const auto &val : hashedData)
+    {
+        std::cout << " " << val;
+    }
+    std::cout << std::endl;
+
+    CsrMatrix<double> hashedRows = transformer.featureHashing({{"apple", "banana"}, {"orange", "apple", "apple"}}, size_t(1) << 20);
+    std::cout << "Signed Hashed Rows:";
+    for (size_t i = 0; i < hashedRows.rows; ++i)
+    {
+        for (size_t k = hashedRows.indptr[i]; k < hashedRows.indptr[i + 1]; ++k)
+        {
+            std::cout << " " << hashedRows.indices[k] << ":" << hashedRows.values[k];
+        }
+        std::cout << " |";
+    }
+    std::cout << std::endl;
+
+    std::cout << "Polynomial Features:";
+    for (const auto &features : polynomialFeatures)
+    {
+        for (const auto &val : features)
+        {
+            std::cout << " " << val;
+        }
+        std::cout << " |";
+    }
+    std::cout << std::endl;
+
+    const std::vector<double> matrix = {1.0, 2.0, 3.0, 4.0}; // 2 rows x 2 columns
+    std::vector<double> matrixFeatures = transformer.addPolynomialFeatures(matrix, 2, 2);
+    std::cout << "Degree-2 Features of 2 Columns (x0 x1 x0^2 x0*x1 x1^2):";
+    for (size_t i = 0; i < matrixFeatures.size(); ++i)
+    {
+        std::cout << " " << matrixFeatures[i] << (i % 5 == 4 ? " |" : "");
+    }
+    std::cout << std::endl;
+
+    CsrMatrix<double> sparseCategories = transformer.oneHotEncode(categories);
+    std::cout << "One-Hot Encoded Categories (column per row):";
+    for (size_t i = 0; i < sparseCategories.rows; ++i)
+    {
+        std::cout << " " << sparseCategories.indices[i];
+    }
+    std::cout << std::endl;
+
+    std::cout << "One-Hot Encoded Categories:";
+    for (const auto &encodedCategory : encodedCategories)
+    {
+        for (const auto &val : encodedCategory)
+        {
+            std::cout << " " << val;
+        }
+        std::cout << " |";
+    }
+    std::cout << std::endl;
+
+    data = {1.0, 2.0, 3.0, 4.0, 5.0};
+    double lambda = 0.5; // within range (-5, 5)
+
+    std::vector<double> boxCoxTransformedData = transformer.boxCoxTransform(data, lambda);
+
+    // Output transformed data
+    std::cout << "Box-Cox Transformed Data:";
+    for (const auto &val : boxCoxTransformedData)
+    {
+        std::cout << " " << val;
+    }
+    std::cout << std::endl;
+
+    std::vector<double> skewed = {1.0, 1.5, 2.0, 3.0, 5.0, 8.0, 13.0, 21.0, 34.0, 55.0};
+    std::cout << "Fitted Box-Cox lambda: " << transformer.fitBoxCoxLambda(skewed) << std::endl;
+
+    std::cout << "Quantile Transformed (uniform):";
+    for (double value : transformer.quantileTransform(skewed))
+    {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+    std::cout << "Quantile Transformed (normal):";
+    for (double value : transformer.quantileTransform(skewed, 1000, true))
+    {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+
+    PowerTransformer yeoJohnson(PowerMethod::YeoJohnson);
+    yeoJohnson.fit(std::vector<std::vector<double>>{{-3.0, 1.0}, {-1.0, 2.0}, {0.0, 4.0}, {2.0, 8.0}, {10.0, 16.0}, {40.0, 32.0}});
+    std::cout << "Fitted Yeo-Johnson lambdas:";
+    for (double fittedLambda : yeoJohnson.getLambdas())
+    {
+        std::cout << " " << fittedLambda;
+    }
+    std::cout << std::endl;
+
+    // float32 storage end to end (double statistics and lambda fit)
+    const std::vector<float> skewedFloat(skewed.begin(), skewed.end());
+    std::cout << "Standardized (float):";
+    for (float value : transformer.standardize(skewedFloat))
+    {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+    std::cout << "Box-Cox with fitted lambda (float):";
+    for (float value : transformer.boxCoxTransform(skewedFloat))
+    {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+    std::cout << "Quantile Transformed (uniform, float):";
+    for (float value : transformer.quantileTransform(skewedFloat))
+    {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+
+    // Per-batch intermediates from one arena: after the first batch the
+    // upstream allocation count stays put
+    BumpArena arena(256);
+    for (size_t batch = 0; batch < 3; ++batch)
+    {
+        arena.reset();
+        std::pmr::vector<double> logs = transformer.logTransform(skewed, &arena);
+        std::pmr::vector<double> scaled = transformer.standardize(logs, &arena);
+        std::pmr::vector<double> expanded = transformer.addPolynomialFeatures(scaled, 2, 2, false, 1, &arena);
+        std::cout << "Arena batch " << batch << ": " << expanded.size() << " features, " << arena.bytesUsed()
+                  << " bytes used, " << arena.getUpstreamAllocations() << " upstream allocations" << std::endl;
+    }
+
+    // Vector kernels against libm, in units in the last place
+    std::vector<double> samples(100000);
+    std::vector<float> samplesFloat(samples.size());
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> exponent(-30.0, 30.0);
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        samples[i] = std::exp(exponent(rng));
+        samplesFloat[i] = static_cast<float>(samples[i]);
+    }
+    auto ulpError = [](auto value, auto reference)
+    {
+        using T = decltype(value);
+        const T spacing = std::nextafter(reference, std::numeric_limits<T>::infinity()) - reference;
+        return static_cast<double>(std::abs(value - reference) / spacing);
+    };
+    std::vector<double> logs(samples.size()), exps(samples.size());
+    std::vector<float> logsFloat(samples.size()), expsFloat(samples.size());
+    vector_log(samples.data(), samples.size(), logs.data());
+    vector_exp(logs.data(), logs.size(), exps.data());
+    vector_log(samplesFloat.data(), samplesFloat.size(), logsFloat.data());
+    vector_exp(logsFloat.data(), logsFloat.size(), expsFloat.data());
+    double worst[4] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        worst[0] = std::max(worst[0], ulpError(logs[i], std::log(samples[i])));
+        worst[1] = std::max(worst[1], ulpError(exps[i], std::exp(logs[i])));
+        worst[2] = std::max(worst[2], ulpError(logsFloat[i], std::log(samplesFloat[i])));
+        worst[3] = std::max(worst[3], ulpError(expsFloat[i], std::exp(logsFloat[i])));
+    }
+    std::cout << "Max ULP error vs libm (log, exp, logf, expf):";
+    bool withinOneUlp = true;
+    for (double w : worst)
+    {
+        std::cout << " " << w;
+        withinOneUlp = withinOneUlp && w <= 1.0;
+    }
+    std::cout << std::endl;
+    if (!withinOneUlp)
+    {
+        std::cerr << "vector log / exp drifted more than 1 ulp from libm" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}